@@ -0,0 +1,76 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+  constexpr std::size_t flags_count = 100000;
+
+  /*
+   * `-I` flags with paths, which are too long for a small string buffer.
+   */
+  std::vector<std::string> const& include_flags() {
+    static std::vector<std::string> tokens = [] {
+      std::vector<std::string> res;
+      for (std::size_t i = 0; i < flags_count; ++i) {
+        res.push_back("-I");
+        res.push_back("/usr/local/include/project/module-" +
+                      std::to_string(i));
+      }
+      return res;
+    }();
+    return tokens;
+  }
+
+  /*
+   * Values of an ordinary multi_argument are accumulated between parses,
+   * so a new command line is created for each parse.
+   */
+  void StdVector(benchmark::State& state) {
+    auto const& tokens = include_flags();
+    bool reserve = state.range(0);
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      cmd.reserve_values(reserve);
+      arg::multi_argument<std::string> inc("include", "I", cmd);
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(inc.get().data());
+    }
+    state.SetItemsProcessed(state.iterations() * flags_count);
+  }
+
+  void Arena(benchmark::State& state) {
+    auto const& tokens = include_flags();
+    arg::command_line cmd("--", "-");
+    cmd.reserve_values(state.range(0));
+    arg::pmr_multi_argument<std::pmr::string> inc("include", "I", cmd);
+
+    for (auto _ : state) {
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(inc.get().data());
+    }
+    state.SetItemsProcessed(state.iterations() * flags_count);
+  }
+
+  void StringView(benchmark::State& state) {
+    auto const& tokens = include_flags();
+    arg::command_line cmd("--", "-");
+    cmd.reserve_values(state.range(0));
+    arg::pmr_multi_argument<std::string_view> inc("include", "I", cmd);
+
+    for (auto _ : state) {
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(inc.get().data());
+    }
+    state.SetItemsProcessed(state.iterations() * flags_count);
+  }
+
+} // namespace
+
+BENCHMARK(StdVector)->ArgName("reserve")->Arg(0)->Arg(1)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(Arena)->ArgName("reserve")->Arg(0)->Arg(1)->Unit(
+    benchmark::kMillisecond);
+BENCHMARK(StringView)->ArgName("reserve")->Arg(0)->Arg(1)->Unit(
+    benchmark::kMillisecond);
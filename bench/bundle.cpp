@@ -0,0 +1,45 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+
+namespace {
+
+  std::string const letters = "abcdefghijklmnopqrstuvwxyz";
+
+  void attach_switches(arg::command_line& cmd,
+                       std::deque<arg::switch_argument>& opts) {
+    for (std::size_t i = 0; i < letters.size(); ++i)
+      opts.emplace_back("", std::string_view(letters).substr(i, 1), cmd);
+    cmd.freeze();
+  }
+
+  void Separate(benchmark::State& state) {
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    attach_switches(cmd, opts);
+
+    std::vector<std::string> tokens;
+    for (char c : letters) tokens.push_back("-" + std::string(1, c));
+    std::vector<std::string_view> vec(tokens.begin(), tokens.end());
+
+    for (auto _ : state) cmd.parse(vec);
+    state.SetItemsProcessed(state.iterations() * letters.size());
+  }
+
+  void Bundled(benchmark::State& state) {
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    attach_switches(cmd, opts);
+
+    std::string token = "-" + letters;
+    std::vector<std::string_view> vec { token };
+
+    for (auto _ : state) cmd.parse(vec);
+    state.SetItemsProcessed(state.iterations() * letters.size());
+  }
+
+} // namespace
+
+BENCHMARK(Separate);
+BENCHMARK(Bundled);
@@ -0,0 +1,196 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+
+namespace {
+
+  /*
+   * Long and short names of `count` options. Arguments keep views of their
+   * names, so the names must outlive them.
+   */
+  struct option_names {
+    explicit option_names(std::size_t count) {
+      for (std::size_t i = 0; i < count; ++i) {
+        longnames.push_back("option-" + std::to_string(i));
+        shortnames.push_back("o" + std::to_string(i));
+      }
+    }
+
+    std::vector<std::string> longnames;
+    std::vector<std::string> shortnames;
+  };
+
+  void attach_switches(arg::command_line& cmd, option_names const& names,
+                       std::deque<arg::switch_argument>& opts) {
+    for (std::size_t i = 0; i < names.longnames.size(); ++i)
+      opts.emplace_back(names.longnames[i], names.shortnames[i], cmd);
+  }
+
+  void Construction(benchmark::State& state) {
+    option_names names(state.range(0));
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      std::deque<arg::switch_argument> opts;
+      attach_switches(cmd, names, opts);
+      cmd.freeze();
+      benchmark::DoNotOptimize(cmd);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  /*
+   * Queries are a mix of long and short names with prefixes, names without
+   * prefixes and strings, which are not names.
+   */
+  std::vector<std::string> make_queries(option_names const& names) {
+    std::vector<std::string> queries;
+    for (std::size_t i = 0; i < names.longnames.size(); i += 3) {
+      queries.push_back("--" + names.longnames[i]);
+      queries.push_back("-" + names.shortnames[i]);
+      queries.push_back(names.longnames[i]);
+      queries.push_back("value-" + std::to_string(i));
+    }
+    return queries;
+  }
+
+  void IsArgument(benchmark::State& state) {
+    option_names names(state.range(0));
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    attach_switches(cmd, names, opts);
+
+    arg::details::command_line_impl impl("--", "-");
+    for (auto& opt : opts) impl.attach_argument(opt);
+    impl.freeze();
+
+    auto queries = make_queries(names);
+    for (auto _ : state) {
+      for (std::string_view q : queries)
+        benchmark::DoNotOptimize(impl.is_argument(q));
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+  }
+
+  void RemovePrefix(benchmark::State& state) {
+    arg::details::command_line_impl impl("--", "-");
+    option_names names(100);
+    auto queries = make_queries(names);
+
+    for (auto _ : state) {
+      for (std::string_view q : queries)
+        benchmark::DoNotOptimize(impl.remove_prefix(q));
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+  }
+
+  void Description(benchmark::State& state) {
+    option_names names(state.range(0));
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    attach_switches(cmd, names, opts);
+    for (auto& opt : opts)
+      opt.add_description("Enables a feature, which is described here");
+
+    for (auto _ : state) {
+      auto lines = cmd.description();
+      benchmark::DoNotOptimize(lines.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  /*
+   * A cached help text is returned without rendering, if `range(1)` is
+   * zero. Otherwise, the width is changed, so it is rendered each time.
+   */
+  void Help(benchmark::State& state) {
+    option_names names(state.range(0));
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    attach_switches(cmd, names, opts);
+    for (auto& opt : opts)
+      opt.add_description("Enables a feature, which is described here");
+    bool render = state.range(1);
+
+    std::size_t width = 80;
+    for (auto _ : state) {
+      if (render) width = width == 80 ? 81 : 80;
+      auto text = cmd.help(width);
+      benchmark::DoNotOptimize(text.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  /*
+   * Completes a prefix, which matches about a tenth of all names.
+   */
+  void Complete(benchmark::State& state) {
+    option_names names(state.range(0));
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    attach_switches(cmd, names, opts);
+    cmd.complete("");
+
+    std::vector<std::string_view> res;
+    for (auto _ : state) {
+      res = cmd.complete("--option-1");
+      benchmark::DoNotOptimize(res.data());
+    }
+    state.counters["matches"] = static_cast<double>(res.size());
+  }
+
+  /*
+   * Answers one query with a fresh command line, like a program does on
+   * each Tab press: arguments are attached, the completion index is built
+   * and queried once. Minus `Construction`, it is a cost of the index.
+   */
+  void CompleteFresh(benchmark::State& state) {
+    option_names names(state.range(0));
+
+    std::size_t matches = 0;
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      std::deque<arg::switch_argument> opts;
+      attach_switches(cmd, names, opts);
+      auto res = cmd.complete("--option-1");
+      matches = res.size();
+      benchmark::DoNotOptimize(res.data());
+    }
+    state.counters["matches"] = static_cast<double>(matches);
+  }
+
+  void MultiArgument(benchmark::State& state) {
+    std::vector<std::string> values;
+    for (std::int64_t i = 0; i < state.range(0); ++i)
+      values.push_back(std::to_string(i));
+    std::vector<std::string_view> vec;
+    for (std::string_view v : values) {
+      vec.push_back("-I");
+      vec.push_back(v);
+    }
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::multi_argument<std::string> include("include", "I", cmd);
+      cmd.parse(vec);
+      benchmark::DoNotOptimize(include.get().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+} // namespace
+
+BENCHMARK(Construction)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(IsArgument)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(RemovePrefix);
+BENCHMARK(Description)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(Help)
+    ->ArgNames({ "options", "render" })
+    ->ArgsProduct({ { 10, 100, 1000 }, { 0, 1 } });
+BENCHMARK(Complete)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(CompleteFresh)->RangeMultiplier(10)->Range(10, 1000);
+BENCHMARK(MultiArgument)
+    ->RangeMultiplier(100)
+    ->Range(100, 1000000)
+    ->Unit(benchmark::kMicrosecond);
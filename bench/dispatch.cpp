@@ -0,0 +1,92 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+
+namespace {
+
+  /*
+   * `count` options, even ones are switches and odd ones take integers.
+   * Each argument is allocated on its own page, so arguments are scattered
+   * in memory like fields of objects of a real program. Arguments keep
+   * views of their names, so the names must outlive them.
+   */
+  struct options {
+    options(std::size_t count, arg::command_line& cmd) {
+      for (std::size_t i = 0; i < count; ++i) {
+        longnames.push_back("option-" + std::to_string(i));
+        shortnames.push_back("o" + std::to_string(i));
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        padding.emplace_back(new char[4096]);
+        if (i % 2 == 0)
+          switches.push_back(std::make_unique<arg::switch_argument>(
+              longnames[i], shortnames[i], cmd));
+        else
+          values.push_back(std::make_unique<arg::pmr_multi_argument<int>>(
+              longnames[i], shortnames[i], cmd));
+      }
+    }
+
+    /*
+     * Gives every option once, in an order, which differs from the order
+     * of attaching.
+     */
+    std::vector<std::string> tokens() const {
+      std::vector<std::string> res;
+      std::size_t count = longnames.size();
+      for (std::size_t i = 0; i < count; ++i) {
+        std::size_t id = i * 7919 % count;
+        if (id % 2 == 0) {
+          res.push_back("--" + longnames[id]);
+        } else {
+          res.push_back("-" + shortnames[id]);
+          res.push_back(std::to_string(id));
+        }
+      }
+      return res;
+    }
+
+    std::vector<std::string> longnames;
+    std::vector<std::string> shortnames;
+    std::vector<std::unique_ptr<arg::switch_argument>> switches;
+    std::vector<std::unique_ptr<arg::pmr_multi_argument<int>>> values;
+    std::vector<std::unique_ptr<char[]>> padding;
+  };
+
+  /*
+   * If `range(1)` is not zero, caches are flushed before each parse, like
+   * in a program, which parses its arguments once at startup.
+   */
+  void Dispatch(benchmark::State& state) {
+    std::size_t count = state.range(0);
+    bool cold = state.range(1);
+    arg::command_line cmd("--", "-");
+    options opts(count, cmd);
+    auto tokens = opts.tokens();
+    cmd.freeze();
+    std::vector<char> evict(cold ? 64 << 20 : 0);
+
+    for (auto _ : state) {
+      if (cold) {
+        state.PauseTiming();
+        for (std::size_t i = 0; i < evict.size(); i += 64) ++evict[i];
+        benchmark::ClobberMemory();
+        state.ResumeTiming();
+      }
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(opts.values.back()->get().data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+  }
+
+} // namespace
+
+BENCHMARK(Dispatch)
+    ->ArgNames({ "options", "cold" })
+    ->ArgsProduct({ { 100, 500, 1000 }, { 0 } });
+// flushing takes much longer than a parse, so iterations are limited
+BENCHMARK(Dispatch)
+    ->ArgNames({ "options", "cold" })
+    ->ArgsProduct({ { 100, 500, 1000 }, { 1 } })
+    ->Iterations(200);
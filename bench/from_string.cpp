@@ -0,0 +1,195 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+  constexpr std::size_t values_count = 1000000;
+
+  std::vector<std::string> const& int_strings() {
+    static std::vector<std::string> strings = [] {
+      std::mt19937 gen(42);
+      std::uniform_int_distribution<int> dist(-1000000, 1000000);
+      std::vector<std::string> res;
+      res.reserve(values_count);
+      for (std::size_t i = 0; i < values_count; ++i)
+        res.push_back(std::to_string(dist(gen)));
+      return res;
+    }();
+    return strings;
+  }
+
+  std::vector<std::string> const& double_strings() {
+    static std::vector<std::string> strings = [] {
+      std::mt19937 gen(42);
+      std::uniform_real_distribution<double> dist(-1e6, 1e6);
+      std::vector<std::string> res;
+      res.reserve(values_count);
+      for (std::size_t i = 0; i < values_count; ++i)
+        res.push_back(std::to_string(dist(gen)));
+      return res;
+    }();
+    return strings;
+  }
+
+  std::vector<std::string> const& word_strings() {
+    static std::vector<std::string> strings = [] {
+      std::vector<std::string> words { "true",  "false", "yes", "no",
+                                       "on",    "off",   "1",   "0",
+                                       "x",     "TRUE" };
+      std::vector<std::string> res;
+      res.reserve(values_count);
+      for (std::size_t i = 0; i < values_count; ++i)
+        res.push_back(words[i % words.size()]);
+      return res;
+    }();
+    return strings;
+  }
+
+  std::vector<std::string> const& hex_strings() {
+    static std::vector<std::string> strings = [] {
+      std::mt19937_64 gen(42);
+      std::vector<std::string> res;
+      res.reserve(values_count);
+      char buf[32];
+      for (std::size_t i = 0; i < values_count; ++i) {
+        auto [ptr, ec] = std::to_chars(buf, buf + sizeof(buf), gen(), 16);
+        res.push_back("0x" + std::string(buf, ptr));
+      }
+      return res;
+    }();
+    return strings;
+  }
+
+  void set_time_per_value(benchmark::State& state, std::size_t count) {
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["time/value"] = benchmark::Counter(
+        static_cast<double>(count),
+        benchmark::Counter::kIsIterationInvariantRate |
+            benchmark::Counter::kInvert);
+  }
+
+  template <typename T>
+  void StreamConversion(benchmark::State& state,
+                        std::vector<std::string> const& strings) {
+    for (auto _ : state) {
+      for (std::string_view s : strings) {
+        T v {};
+        benchmark::DoNotOptimize(arg::details::stream_from_string(s, v));
+        benchmark::DoNotOptimize(v);
+      }
+    }
+    set_time_per_value(state, strings.size());
+  }
+
+  template <typename T>
+  void FromCharsConversion(benchmark::State& state,
+                           std::vector<std::string> const& strings) {
+    for (auto _ : state) {
+      for (std::string_view s : strings) {
+        T v = arg::util::from_string<T>(s);
+        benchmark::DoNotOptimize(v);
+      }
+    }
+    set_time_per_value(state, strings.size());
+  }
+
+  /*
+   * Converts strings, some of which may be invalid values of `T`.
+   */
+  template <typename T>
+  void TryConversion(benchmark::State& state,
+                     std::vector<std::string> const& strings) {
+    for (auto _ : state) {
+      for (std::string_view s : strings) {
+        T v {};
+        benchmark::DoNotOptimize(arg::util::try_from_string(s, v));
+        benchmark::DoNotOptimize(v);
+      }
+    }
+    set_time_per_value(state, strings.size());
+  }
+
+  /*
+   * A value_argument accepts a value only once per command line, so all
+   * values are passed to a multi_argument, which converts them the same way.
+   */
+  template <typename T>
+  void ArgumentParse(benchmark::State& state,
+                     std::vector<std::string> const& strings) {
+    std::vector<std::string_view> vec;
+    vec.reserve(strings.size() * 2);
+    for (std::string_view s : strings) {
+      vec.push_back("-v");
+      vec.push_back(s);
+    }
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::multi_argument<T> v("value", "v", cmd);
+      cmd.parse(vec);
+      benchmark::DoNotOptimize(v.get().data());
+    }
+    set_time_per_value(state, strings.size());
+  }
+
+  void StreamInt(benchmark::State& state) {
+    StreamConversion<int>(state, int_strings());
+  }
+
+  void FromCharsInt(benchmark::State& state) {
+    FromCharsConversion<int>(state, int_strings());
+  }
+
+  void StreamDouble(benchmark::State& state) {
+    StreamConversion<double>(state, double_strings());
+  }
+
+  void FromCharsDouble(benchmark::State& state) {
+    FromCharsConversion<double>(state, double_strings());
+  }
+
+  void ArgumentParseInt(benchmark::State& state) {
+    ArgumentParse<int>(state, int_strings());
+  }
+
+  void ArgumentParseDouble(benchmark::State& state) {
+    ArgumentParse<double>(state, double_strings());
+  }
+
+  void FromStringBool(benchmark::State& state) {
+    TryConversion<bool>(state, word_strings());
+  }
+
+  void FromStringChar(benchmark::State& state) {
+    TryConversion<char>(state, word_strings());
+  }
+
+  void FromStringString(benchmark::State& state) {
+    TryConversion<std::string>(state, word_strings());
+  }
+
+  void FromStringStringView(benchmark::State& state) {
+    TryConversion<std::string_view>(state, word_strings());
+  }
+
+  void FromStringHex(benchmark::State& state) {
+    TryConversion<std::uint64_t>(state, hex_strings());
+  }
+
+} // namespace
+
+BENCHMARK(StreamInt)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromCharsInt)->Unit(benchmark::kMillisecond);
+BENCHMARK(StreamDouble)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromCharsDouble)->Unit(benchmark::kMillisecond);
+BENCHMARK(ArgumentParseInt)->Unit(benchmark::kMillisecond);
+BENCHMARK(ArgumentParseDouble)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromStringBool)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromStringChar)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromStringString)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromStringStringView)->Unit(benchmark::kMillisecond);
+BENCHMARK(FromStringHex)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,55 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+
+namespace {
+
+  constexpr std::size_t knobs_count = 64;
+
+  /*
+   * Names and floating point values of tuning knobs. Arguments keep views of
+   * their names, so the names must outlive them.
+   */
+  struct knobs {
+    knobs() {
+      for (std::size_t i = 0; i < knobs_count; ++i) {
+        names.push_back("knob-" + std::to_string(i));
+        tokens.push_back("--" + names.back());
+        tokens.push_back(std::to_string(i) + ".125e-3");
+      }
+    }
+
+    std::vector<std::string> names;
+    std::vector<std::string> tokens;
+  };
+
+  /*
+   * Parses all knobs and reads `range(1)` of them, conversion is lazy, if
+   * `range(0)` is not zero.
+   */
+  void Knobs(benchmark::State& state) {
+    knobs k;
+    bool lazy = state.range(0);
+    std::size_t read = state.range(1);
+
+    // a value_argument accepts a single occurrence, so a new command line
+    // is created for each parse
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      cmd.lazy_conversion(lazy);
+      std::deque<arg::value_argument<double>> args;
+      for (auto const& name : k.names) args.emplace_back(name, "", cmd);
+      cmd.parse(k.tokens);
+      double sum = 0;
+      for (std::size_t i = 0; i < read; ++i) sum += args[i].get();
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * knobs_count);
+  }
+
+} // namespace
+
+BENCHMARK(Knobs)
+    ->ArgNames({ "lazy", "read" })
+    ->ArgsProduct({ { 0, 1 }, { 0, 4, 64 } });
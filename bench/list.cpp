@@ -0,0 +1,100 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <charconv>
+#include <string>
+
+namespace {
+
+  /*
+   * About 1 MB of comma separated integers.
+   */
+  std::string const& integer_list() {
+    static std::string list = [] {
+      std::string res;
+      for (unsigned i = 0; res.size() < (1u << 20); ++i) {
+        if (i > 0) res += ',';
+        res += std::to_string(i * 2654435761u % 1000000);
+      }
+      return res;
+    }();
+    return list;
+  }
+
+  std::size_t elements_count() {
+    auto const& list = integer_list();
+    return std::count(list.begin(), list.end(), ',') + 1;
+  }
+
+  /*
+   * Splits with `std::string_view::find` and appends to a vector, which is
+   * not reserved.
+   */
+  void Naive(benchmark::State& state) {
+    std::string_view list = integer_list();
+
+    for (auto _ : state) {
+      std::vector<int> values;
+      std::size_t start = 0;
+      while (true) {
+        std::size_t end = list.find(',', start);
+        if (end == std::string_view::npos) end = list.size();
+        int v = 0;
+        std::from_chars(list.data() + start, list.data() + end, v);
+        values.push_back(v);
+        if (end == list.size()) break;
+        start = end + 1;
+      }
+      benchmark::DoNotOptimize(values.data());
+    }
+    state.SetBytesProcessed(state.iterations() * list.size());
+    state.SetItemsProcessed(state.iterations() * elements_count());
+  }
+
+  void Split(benchmark::State& state) {
+    std::string_view list = integer_list();
+
+    for (auto _ : state) {
+      std::size_t size = 0;
+      arg::details::split(list, ',', [&size](std::string_view s) {
+        size += s.size();
+        return true;
+      });
+      benchmark::DoNotOptimize(size);
+    }
+    state.SetBytesProcessed(state.iterations() * list.size());
+    state.SetItemsProcessed(state.iterations() * elements_count());
+  }
+
+  void Integers(benchmark::State& state) {
+    std::vector<std::string_view> tokens { "--ids", integer_list() };
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::list_argument<int> ids("ids", "i", cmd);
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(ids.get().data());
+    }
+    state.SetBytesProcessed(state.iterations() * integer_list().size());
+    state.SetItemsProcessed(state.iterations() * elements_count());
+  }
+
+  void Views(benchmark::State& state) {
+    std::vector<std::string_view> tokens { "--ids", integer_list() };
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::list_argument<std::string_view> ids("ids", "i", cmd);
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(ids.get().data());
+    }
+    state.SetBytesProcessed(state.iterations() * integer_list().size());
+    state.SetItemsProcessed(state.iterations() * elements_count());
+  }
+
+} // namespace
+
+BENCHMARK(Naive)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Split)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Integers)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Views)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,83 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <map>
+#include <string>
+
+namespace {
+
+  std::vector<std::string> make_names(std::size_t count) {
+    std::vector<std::string> names;
+    names.reserve(count * 2);
+    for (std::size_t i = 0; i < count; ++i) {
+      names.push_back("option-" + std::to_string(i));
+      names.push_back("o" + std::to_string(i));
+    }
+    return names;
+  }
+
+  std::vector<std::string_view> make_queries(
+      std::vector<std::string> const& names) {
+    std::vector<std::string_view> queries;
+    queries.reserve(names.size());
+    for (std::size_t i = 0; i < names.size(); i += 7)
+      queries.push_back(names[i]);
+    return queries;
+  }
+
+  void MapLookup(benchmark::State& state) {
+    auto names = make_names(state.range(0));
+    auto queries = make_queries(names);
+
+    std::map<std::string_view, std::size_t> map;
+    for (std::size_t i = 0; i < names.size(); ++i) map.insert({ names[i], i });
+
+    for (auto _ : state) {
+      for (std::string_view q : queries) {
+        auto it = map.find(q);
+        benchmark::DoNotOptimize(it);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+  }
+
+  void FrozenIndexLookup(benchmark::State& state) {
+    auto names = make_names(state.range(0));
+    auto queries = make_queries(names);
+
+    arg::details::name_index index;
+    index.reset(names.size());
+    for (std::size_t i = 0; i < names.size(); ++i) index.insert(names[i], i);
+
+    for (auto _ : state) {
+      for (std::string_view q : queries) {
+        auto id = index.find(q);
+        benchmark::DoNotOptimize(id);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+  }
+
+  void Parse(benchmark::State& state) {
+    auto names = make_names(state.range(0));
+
+    arg::command_line cmd("--", "-");
+    std::deque<arg::switch_argument> opts;
+    for (std::size_t i = 0; i < names.size(); i += 2)
+      opts.emplace_back(names[i], names[i + 1], cmd);
+    cmd.freeze();
+
+    std::vector<std::string> tokens;
+    for (std::size_t i = 0; i < names.size(); i += 14)
+      tokens.push_back("--" + names[i]);
+    std::vector<std::string_view> vec(tokens.begin(), tokens.end());
+
+    for (auto _ : state) cmd.parse(vec);
+    state.SetItemsProcessed(state.iterations() * vec.size());
+  }
+
+} // namespace
+
+BENCHMARK(MapLookup)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(FrozenIndexLookup)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(Parse)->Arg(10)->Arg(100)->Arg(1000);
@@ -0,0 +1,64 @@
+#include <argueme/arg.hpp>
+#include <argueme/response_files.hpp>
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+  /*
+   * Writes a 50 MB response file of include directories and defines, some
+   * of them quoted, and returns `@path`.
+   */
+  std::string const& response_file() {
+    static std::string const arg = [] {
+      auto path =
+          std::filesystem::temp_directory_path() / "argueme_bench.rsp";
+      std::ofstream os(path, std::ios::binary);
+      std::size_t written = 0;
+      for (std::size_t i = 0; written < 50 * 1024 * 1024; ++i) {
+        std::string line = "-I /usr/local/include/project/module" +
+                           std::to_string(i) + "\n";
+        if (i % 10 == 0)
+          line += "-I \"/opt/with space/" + std::to_string(i) + "\"\n";
+        os << line;
+        written += line.size();
+      }
+      return "@" + path.string();
+    }();
+    return arg;
+  }
+
+  void ResponseFileParse(benchmark::State& state) {
+    std::vector<std::string_view> vec { response_file() };
+    auto size = std::filesystem::file_size(vec[0].substr(1));
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::response_files responses(cmd);
+      arg::multi_argument<std::string_view> include("include", "I", cmd);
+      cmd.parse(vec);
+      benchmark::DoNotOptimize(include.get().data());
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+
+  void ResponseFileTokenize(benchmark::State& state) {
+    std::string path(response_file().substr(1));
+    auto size = std::filesystem::file_size(path);
+    std::vector<std::string_view> tokens;
+
+    for (auto _ : state) {
+      arg::details::mapped_file file(path);
+      tokens.clear();
+      arg::details::tokenize_in_place(file.data(), file.size(), tokens);
+      benchmark::DoNotOptimize(tokens.data());
+    }
+    state.SetBytesProcessed(state.iterations() * size);
+  }
+
+} // namespace
+
+BENCHMARK(ResponseFileTokenize)->Unit(benchmark::kMillisecond);
+BENCHMARK(ResponseFileParse)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+#include <argueme/schema.hpp>
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <deque>
+#include <string>
+#include <thread>
+
+namespace {
+
+  struct console_schema {
+    arg::schema s { "--", "-" };
+    arg::option_key<int> level = s.add_value<int>("level", "l");
+    arg::option_key<std::string_view> user =
+        s.add_value<std::string_view>("user", "u");
+    arg::option_key<std::vector<int>> ids = s.add_multi<int>("id", "i");
+    arg::option_key<bool> force = s.add_switch("force", "f");
+    arg::option_key<std::string_view> cmd =
+        s.add_positional<std::string_view>(true);
+
+    console_schema() {
+      for (int i = 0; i < 100; ++i)
+        s.add_switch(names.emplace_back("knob-" + std::to_string(i)), "");
+      s.freeze();
+    }
+
+    std::deque<std::string> names;
+  };
+
+  console_schema const& shared_schema() {
+    static console_schema const schema;
+    return schema;
+  }
+
+  /*
+   * Each thread parses admin console commands with one shared schema and
+   * its own result.
+   */
+  void ConcurrentParse(benchmark::State& state) {
+    auto const& cs = shared_schema();
+    std::vector<std::string_view> vec { "reindex", "--level", "3", "-u",
+                                        "admin",   "-i",      "1", "-i",
+                                        "2",       "--force", "--knob-42" };
+    auto [begin, end] = arg::details::make_cursors(vec.data(), vec.size());
+    arg::parse_result res(cs.s);
+
+    for (auto _ : state) {
+      cs.s.parse(begin, end, res);
+      benchmark::DoNotOptimize(res.get(cs.level));
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  std::string const& recorded_invocations() {
+    static std::string const buffer = [] {
+      std::string res;
+      for (int i = 0; i < 1000000; ++i) {
+        res += "job" + std::to_string(i % 100) + " --level " +
+               std::to_string(i % 5) + " -u operator -i " + std::to_string(i);
+        if (i % 20 == 0) res += " --unknown";
+        if (i % 3 == 0) res += " --force";
+        res += '\n';
+      }
+      return res;
+    }();
+    return buffer;
+  }
+
+  /*
+   * Validates one million recorded invocations, 5% of them are invalid.
+   */
+  void BatchParse(benchmark::State& state) {
+    auto const& cs = shared_schema();
+    auto const& buffer = recorded_invocations();
+
+    for (auto _ : state) {
+      auto res = cs.s.parse_batch(buffer, state.range(0));
+      benchmark::DoNotOptimize(res.failures());
+    }
+    state.SetItemsProcessed(state.iterations() * 1000000);
+  }
+
+} // namespace
+
+BENCHMARK(BatchParse)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(ConcurrentParse)
+    ->ThreadRange(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->UseRealTime();
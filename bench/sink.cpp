@@ -0,0 +1,81 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+  constexpr std::size_t files_count = 100000;
+
+  std::vector<std::string> const& file_flags() {
+    static std::vector<std::string> tokens = [] {
+      std::vector<std::string> res;
+      for (std::size_t i = 0; i < files_count; ++i) {
+        res.push_back("--file");
+        res.push_back("/var/lib/project/data/file-" + std::to_string(i));
+      }
+      return res;
+    }();
+    return tokens;
+  }
+
+  /*
+   * All values are accumulated and processed after parsing.
+   */
+  void Vector(benchmark::State& state) {
+    auto const& tokens = file_flags();
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::multi_argument<std::string> file("file", "f", cmd);
+      cmd.parse(tokens);
+      std::size_t size = 0;
+      for (auto const& f : file.get()) size += f.size();
+      benchmark::DoNotOptimize(size);
+    }
+    state.SetItemsProcessed(state.iterations() * files_count);
+  }
+
+  /*
+   * Each value is handed over to a callback of `multi_argument`.
+   */
+  void Value(benchmark::State& state) {
+    auto const& tokens = file_flags();
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      std::size_t size = 0;
+      arg::multi_argument<std::string> file("file", "f", cmd);
+      file.on_value([&size](std::string&& f) { size += f.size(); });
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(size);
+    }
+    state.SetItemsProcessed(state.iterations() * files_count);
+  }
+
+  void Batch(benchmark::State& state) {
+    auto const& tokens = file_flags();
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      std::size_t size = 0;
+      arg::sink_argument<std::string> file(
+          "file", "f", cmd,
+          [&size](std::vector<std::string>& batch) {
+            for (auto const& f : batch) size += f.size();
+          },
+          state.range(0));
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(size);
+    }
+    state.SetItemsProcessed(state.iterations() * files_count);
+  }
+
+} // namespace
+
+BENCHMARK(Vector)->Unit(benchmark::kMillisecond);
+BENCHMARK(Value)->Unit(benchmark::kMillisecond);
+BENCHMARK(Batch)
+    ->ArgName("size")
+    ->Arg(16)
+    ->Arg(256)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,98 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace {
+
+  constexpr std::size_t options_count = 20;
+
+  /*
+   * Names of subcommands and of their options. Arguments keep views of
+   * their names, so the names must outlive them.
+   */
+  struct names {
+    explicit names(std::size_t count) {
+      for (std::size_t i = 0; i < count; ++i)
+        commands.push_back("command-" + std::to_string(i));
+      for (std::size_t i = 0; i < options_count; ++i)
+        options.push_back("option-" + std::to_string(i));
+    }
+
+    std::vector<std::string> commands;
+    std::vector<std::string> options;
+  };
+
+  names const& all_names() {
+    static names n(1000);
+    return n;
+  }
+
+  struct tool : arg::subcommand {
+    tool() : arg::subcommand("--", "-") {
+      for (auto const& name : all_names().options)
+        options.emplace_back(name, "", cmdline);
+    }
+
+    std::deque<arg::value_argument<int>> options;
+  };
+
+  std::vector<std::string_view> make_tokens(std::size_t count) {
+    auto const& n = all_names();
+    return { n.commands[count / 2], "--option-3", "7", "--option-9", "8" };
+  }
+
+  /*
+   * Every subcommand parser is constructed upfront and the matched one is
+   * called from a command.
+   */
+  void Eager(benchmark::State& state) {
+    std::size_t count = state.range(0);
+    auto const& n = all_names();
+    auto tokens = make_tokens(count);
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      std::deque<tool> tools(count);
+      std::deque<arg::command<std::function<void()>>> commands;
+      for (std::size_t i = 0; i < count; ++i) {
+        auto& sub = tools[i].parser();
+        commands.emplace_back(n.commands[i], "", cmd, [&cmd, &sub] {
+          cmd.stop();
+          auto [begin, end] = cmd.get_iterator();
+          sub.parse(++begin, end);
+        });
+      }
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(tools[count / 2].options[3].get());
+    }
+  }
+
+  void Lazy(benchmark::State& state) {
+    std::size_t count = state.range(0);
+    auto const& n = all_names();
+    auto tokens = make_tokens(count);
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::subcommands tools(cmd);
+      for (std::size_t i = 0; i < count; ++i) tools.add<tool>(n.commands[i]);
+      cmd.parse(tokens);
+      benchmark::DoNotOptimize(tools.get_as<tool>()->options[3].get());
+    }
+  }
+
+} // namespace
+
+BENCHMARK(Eager)
+    ->ArgName("subcommands")
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(Lazy)
+    ->ArgName("subcommands")
+    ->RangeMultiplier(10)
+    ->Range(10, 1000)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,61 @@
+#include <argueme/token_stream.hpp>
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+
+namespace {
+
+  constexpr std::size_t flags_count = 100000;
+
+  std::string const& include_text() {
+    static std::string text = [] {
+      std::string res;
+      for (std::size_t i = 0; i < flags_count; ++i)
+        res.append("-I /usr/include/module-").append(std::to_string(i) + " ");
+      return res.append("\n");
+    }();
+    return text;
+  }
+
+  /*
+   * Values are consumed by a callback, so memory does not grow with an
+   * input.
+   */
+  void Stream(benchmark::State& state) {
+    auto const& text = include_text();
+
+    for (auto _ : state) {
+      std::istringstream is(text);
+      arg::token_stream input(is);
+      arg::command_line cmd("--", "-");
+      arg::multi_argument<std::string> inc("include", "I", cmd);
+      std::size_t size = 0;
+      inc.on_value([&size](std::string&& v) { size += v.size(); });
+      auto [begin, end] = input.cursors();
+      cmd.parse(begin, end);
+      benchmark::DoNotOptimize(size);
+    }
+    state.SetItemsProcessed(state.iterations() * flags_count);
+    state.SetBytesProcessed(state.iterations() * text.size());
+  }
+
+  /*
+   * The whole input is split in advance and values are accumulated.
+   */
+  void Vector(benchmark::State& state) {
+    auto const& text = include_text();
+
+    for (auto _ : state) {
+      arg::command_line cmd("--", "-");
+      arg::multi_argument<std::string> inc("include", "I", cmd);
+      cmd.parse_line(text);
+      benchmark::DoNotOptimize(inc.get().data());
+    }
+    state.SetItemsProcessed(state.iterations() * flags_count);
+    state.SetBytesProcessed(state.iterations() * text.size());
+  }
+
+} // namespace
+
+BENCHMARK(Stream)->Unit(benchmark::kMillisecond);
+BENCHMARK(Vector)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,57 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+
+namespace {
+
+  /*
+   * Makes a command line of about `size` bytes with long plain arguments
+   * and a quoted argument every 16 arguments.
+   */
+  std::string make_line(std::size_t size) {
+    std::string line;
+    for (std::size_t i = 0; line.size() < size; ++i) {
+      if (i % 16 == 0) line += "--message 'quoted value " + std::to_string(i);
+      else line += "--define /some/rather/long/path/component" +
+                   std::to_string(i);
+      line += ' ';
+    }
+    return line;
+  }
+
+  /*
+   * A naive splitting, which the library replaces. It does not handle
+   * quotes at all.
+   */
+  void IstreamSplit(benchmark::State& state) {
+    std::string line = make_line(state.range(0));
+    std::vector<std::string> args;
+
+    for (auto _ : state) {
+      args.clear();
+      std::istringstream is(line);
+      std::string s;
+      while (is >> s) args.push_back(s);
+      benchmark::DoNotOptimize(args.data());
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+  }
+
+  void Tokenize(benchmark::State& state) {
+    std::string line = make_line(state.range(0));
+    std::vector<std::string_view> args;
+    std::string storage;
+
+    for (auto _ : state) {
+      args.clear();
+      arg::details::tokenize(line, args, storage);
+      benchmark::DoNotOptimize(args.data());
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+  }
+
+} // namespace
+
+BENCHMARK(IstreamSplit)->Range(1 << 10, 1 << 20);
+BENCHMARK(Tokenize)->Range(1 << 10, 1 << 20);
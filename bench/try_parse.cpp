@@ -0,0 +1,58 @@
+#include <argueme/arg.hpp>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+
+  /*
+   * Recorded invocations, every twentieth of them is invalid.
+   */
+  std::vector<std::vector<std::string>> make_lines(std::size_t count) {
+    std::vector<std::vector<std::string>> lines;
+    for (std::size_t i = 0; i < count; ++i) {
+      std::string level = i % 20 == 19 ? "x" : std::to_string(i % 10);
+      lines.push_back({ "--level", level, "-v", "--name", "value" });
+    }
+    return lines;
+  }
+
+  void Throwing(benchmark::State& state) {
+    arg::command_line cmd("--", "-");
+    arg::multi_argument<int> level("level", "l", cmd);
+    arg::multi_argument<std::string> name("name", "n", cmd);
+    arg::switch_argument verbose("verbose", "v", cmd);
+    auto lines = make_lines(1000);
+
+    std::size_t failures = 0;
+    for (auto _ : state) {
+      for (auto const& line : lines) {
+        try {
+          cmd.parse(line);
+        } catch (arg::argument_error const&) {
+          ++failures;
+        }
+      }
+    }
+    benchmark::DoNotOptimize(failures);
+    state.SetItemsProcessed(state.iterations() * lines.size());
+  }
+
+  void NotThrowing(benchmark::State& state) {
+    arg::command_line cmd("--", "-");
+    arg::multi_argument<int> level("level", "l", cmd);
+    arg::multi_argument<std::string> name("name", "n", cmd);
+    arg::switch_argument verbose("verbose", "v", cmd);
+    auto lines = make_lines(1000);
+
+    std::size_t failures = 0;
+    for (auto _ : state) {
+      for (auto const& line : lines) failures += !cmd.try_parse(line);
+    }
+    benchmark::DoNotOptimize(failures);
+    state.SetItemsProcessed(state.iterations() * lines.size());
+  }
+
+} // namespace
+
+BENCHMARK(Throwing);
+BENCHMARK(NotThrowing);
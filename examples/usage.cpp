@@ -85,10 +85,7 @@
 #include <argueme/arg.hpp>
 #include <iostream>
 
-void print_help(arg::command_line const& cmd) {
-  auto descs = cmd.description();
-  for (std::string const& s : descs) std::cout << s << std::endl;
-}
+void print_help(arg::command_line const& cmd) { cmd.write_help(std::cout); }
 
 int main(int argc, char** argv) {
   arg::command_line cmd("--", "-");
@@ -1,16 +1,76 @@
 #ifndef ARGUEMEFWD_HPP
 #define ARGUEMEFWD_HPP
 
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <exception>
 #include <functional>
-#include <map>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#if !defined(ARGUEME_NO_SIMD) && defined(__AVX2__)
+  #include <immintrin.h>
+  #define ARGUEME_SIMD_AVX2 1
+#else
+  #define ARGUEME_SIMD_AVX2 0
+#endif
+
+#if !defined(ARGUEME_NO_SIMD) &&                                              \
+    (defined(__SSE2__) || defined(_M_X64) ||                                  \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+  #include <emmintrin.h>
+  #define ARGUEME_SIMD_SSE2 1
+#else
+  #define ARGUEME_SIMD_SSE2 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  #include <intrin.h>
+#endif
+
+/*
+ * Instrumentation of parsing: counters and timings of its phases. Disabled
+ * by default, then it adds neither code nor data.
+ */
+#ifndef ARGUEME_INSTRUMENT
+  #define ARGUEME_INSTRUMENT 0
+#endif
+
+#if ARGUEME_INSTRUMENT
+  #include <chrono>
+  #include <mutex>
+#endif
+
+/*
+ * POSIX file descriptors, which `write_help` and `token_stream` accept.
+ */
+#ifndef ARGUEME_HAS_POSIX_IO
+  #if defined(__unix__) || defined(__APPLE__)
+    #define ARGUEME_HAS_POSIX_IO 1
+  #else
+    #define ARGUEME_HAS_POSIX_IO 0
+  #endif
+#endif
+
+#if ARGUEME_HAS_POSIX_IO
+  #include <unistd.h>
+#endif
+
 namespace arg {
 
   class argument_error : public std::exception {
@@ -50,10 +110,320 @@ namespace arg {
     std::string info_str;
   };
 
+  /*
+   * Codes of errors, returned by `try_parse`. `parse` throws
+   * `argument_error` with a message of the code instead.
+   */
+  enum class parse_errc {
+    ok = 0,
+    unrecognized_argument,
+    prefix_error,
+    value_required,
+    repeated_option,
+    unexpected_value,
+    positional_required,
+    invalid_value,
+    unterminated_quote,
+    read_error
+  };
+
+  constexpr char const* error_message(parse_errc code) noexcept {
+    switch (code) {
+      case parse_errc::ok: return "";
+      case parse_errc::unrecognized_argument: return "Unrecognized argument";
+      case parse_errc::prefix_error: return "Prefix error";
+      case parse_errc::value_required: return "Option requires a value";
+      case parse_errc::repeated_option:
+        return "Option can be appeared only once";
+      case parse_errc::unexpected_value:
+        return "Option does not take a value";
+      case parse_errc::positional_required:
+        return "Positional argument required";
+      case parse_errc::invalid_value: return "Cannot convert a string";
+      case parse_errc::unterminated_quote: return "Unterminated quote";
+      case parse_errc::read_error: return "Arguments can not be read";
+    }
+    return "";
+  }
+
+  /*
+   * Error of `try_parse`. `token` is an argument, which caused the error,
+   * `index` is its position in a parsed range. `value` is a string, which
+   * can not be converted, if the code is `invalid_value`. Strings are views
+   * of parsed arguments, so an error is created without allocations.
+   */
+  struct parse_error {
+    parse_errc code = parse_errc::ok;
+    std::string_view token;
+    std::size_t index = 0;
+    std::string_view value;
+  };
+
+  /*
+   * Result of `try_parse`: nothing or a `parse_error`, like
+   * `std::expected<void, parse_error>`.
+   */
+  class parse_status {
+  public:
+    parse_status() noexcept = default;
+
+    parse_status(parse_error error) noexcept : err(error) {}
+
+    bool has_value() const noexcept { return err.code == parse_errc::ok; }
+
+    explicit operator bool() const noexcept { return has_value(); }
+
+    parse_error const& error() const noexcept { return err; }
+  private:
+    parse_error err;
+  };
+
+  /*
+   * Phases of parsing, which are measured by instrumentation.
+   */
+  enum class parse_phase {
+    lookup,
+    remove_prefix,
+    conversion,
+    command,
+    help,
+    error
+  };
+
+  /*
+   * Kinds of string conversions, as they are done by `util::from_string`.
+   */
+  enum class conversion_kind {
+    string,
+    boolean,
+    character,
+    integer,
+    floating,
+    stream
+  };
+
+  struct phase_stats {
+    std::uint64_t count = 0;
+    std::uint64_t nanoseconds = 0;
+  };
+
+  /*
+   * Counters and cumulative time of parsing phases of a command line.
+   * `errors` counts errors of `try_parse` and exceptions, which are thrown
+   * through a parsing.
+   */
+  struct parse_stats {
+    phase_stats lookup;
+    phase_stats remove_prefix;
+    std::array<phase_stats, 6> conversions;
+    phase_stats commands;
+    phase_stats help;
+    std::uint64_t errors = 0;
+
+    phase_stats const& conversion(conversion_kind kind) const noexcept {
+      return conversions[static_cast<std::size_t>(kind)];
+    }
+  };
+
+  /*
+   * One measurement, passed to an observer. `token` is an argument, which
+   * is parsed, it is empty for a help rendering.
+   */
+  struct parse_event {
+    parse_phase phase;
+    conversion_kind kind;
+    std::string_view token;
+    std::uint64_t nanoseconds;
+  };
+
+  using parse_observer = std::function<void(parse_event const&)>;
+
   enum class prefix_policy { require, do_not_require, optional };
 
+  enum class completion_shell { bash, zsh, fish };
+
+  /*
+   * Layer of a command line, which has supplied a value of an argument.
+   */
+  enum class value_source { none, command_line, environment, config_file };
+
+  namespace util {
+
+    template <typename T>
+    bool try_from_string(std::string_view s, T& res);
+
+  } // namespace util
+
   namespace details {
 
+    /*
+     * Checks if `T` is `std::string` with any allocator, for example
+     * `std::pmr::string`.
+     */
+    template <typename T>
+    struct is_char_string : std::false_type {};
+
+    template <class Traits, class Allocator>
+    struct is_char_string<std::basic_string<char, Traits, Allocator>>
+        : std::true_type {};
+
+    template <typename T>
+    constexpr bool is_char_string_v = is_char_string<T>::value;
+
+    template <typename T>
+    constexpr conversion_kind conversion_kind_of() noexcept {
+      if constexpr (std::is_same_v<T, std::string_view> ||
+                    is_char_string_v<T>)
+        return conversion_kind::string;
+      else if constexpr (std::is_same_v<T, bool>)
+        return conversion_kind::boolean;
+      else if constexpr (std::is_same_v<T, char> ||
+                         std::is_same_v<T, signed char> ||
+                         std::is_same_v<T, unsigned char>)
+        return conversion_kind::character;
+      else if constexpr (std::is_integral_v<T>)
+        return conversion_kind::integer;
+      else if constexpr (std::is_floating_point_v<T>)
+        return conversion_kind::floating;
+      else return conversion_kind::stream;
+    }
+
+#if ARGUEME_INSTRUMENT
+    /*
+     * Statistics of a command line and an observer of its measurements.
+     * Deferred commands may be executed on many threads, so a record is
+     * made under a lock and calls of an observer are serialized.
+     */
+    class probe {
+    public:
+      using clock = std::chrono::steady_clock;
+
+      /*
+       * Calls `f` and records its time, even if it throws.
+       */
+      template <class F>
+      decltype(auto) measure(parse_phase phase, conversion_kind kind,
+                             std::string_view token, F&& f) {
+        struct finisher {
+          probe& self;
+          parse_event event;
+          clock::time_point start;
+
+          ~finisher() {
+            auto time = clock::now() - start;
+            event.nanoseconds = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time)
+                    .count());
+            self.record(event);
+          }
+        } finish { *this, { phase, kind, token, 0 }, clock::now() };
+        return f();
+      }
+
+      void error(std::string_view token) {
+        record({ parse_phase::error, conversion_kind::string, token, 0 });
+      }
+
+      void record(parse_event const& event) {
+        std::lock_guard<std::mutex> lock(m);
+        phase_stats* ps = nullptr;
+        switch (event.phase) {
+          case parse_phase::lookup: ps = &stats.lookup; break;
+          case parse_phase::remove_prefix: ps = &stats.remove_prefix; break;
+          case parse_phase::conversion:
+            ps = &stats.conversions[static_cast<std::size_t>(event.kind)];
+            break;
+          case parse_phase::command: ps = &stats.commands; break;
+          case parse_phase::help: ps = &stats.help; break;
+          case parse_phase::error: ++stats.errors; break;
+        }
+        if (ps) {
+          ++ps->count;
+          ps->nanoseconds += event.nanoseconds;
+        }
+        if (observer) observer(event);
+      }
+
+      parse_stats snapshot() const {
+        std::lock_guard<std::mutex> lock(m);
+        return stats;
+      }
+
+      void reset() {
+        std::lock_guard<std::mutex> lock(m);
+        stats = parse_stats {};
+      }
+
+      void observe(parse_observer f) {
+        std::lock_guard<std::mutex> lock(m);
+        observer = std::move(f);
+      }
+
+    private:
+      mutable std::mutex m;
+      parse_stats stats;
+      parse_observer observer;
+    };
+#endif
+
+    inline std::string conversion_message(std::string_view s) {
+      std::string msg { "Cannot convert a string `" };
+      msg.append(s);
+      msg.append("` to a value");
+      return msg;
+    }
+
+    /*
+     * Throws `argument_error`, which is thrown by `parse` for an error of
+     * `try_parse`.
+     */
+    [[noreturn]] inline void throw_parse_error(parse_error const& e) {
+      if (e.code == parse_errc::invalid_value)
+        throw argument_error(conversion_message(e.value),
+                             std::string { e.token });
+      throw argument_error(std::string { error_message(e.code) },
+                           std::string { e.token });
+    }
+
+    inline bool is_space(char c) noexcept {
+      return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    /*
+     * Checks if `str` starts with `subs`.
+     */
+    constexpr bool starts_with(std::string_view str, std::string_view subs) {
+      return str.substr(0, subs.size()) == subs;
+    }
+
+    /*
+     * Checks, if `s` starts with longname or shortname prefix. If so, returns
+     * `std::string_view` without these first characters. Otherwise, returns
+     * `s` itself. The second value is true, if a prefix has been removed.
+     */
+    constexpr std::pair<std::string_view, bool>
+        remove_prefix(std::string_view s, std::string_view lname_prefix,
+                      std::string_view sname_prefix) {
+      bool starts_lname = starts_with(s, lname_prefix);
+      bool starts_sname = starts_with(s, sname_prefix);
+      if (starts_sname && !starts_lname) {
+        return { s.substr(sname_prefix.size()), true };
+      } else if (starts_lname) {
+        return { s.substr(lname_prefix.size()), true };
+      }
+      return { s, false };
+    }
+
+    /*
+     * Checks, if presence or absence of a prefix satisfies `policy`.
+     */
+    constexpr bool check_prefix(prefix_policy policy, bool has_prefix) {
+      if ((has_prefix && policy == prefix_policy::do_not_require) ||
+          (!has_prefix && policy == prefix_policy::require))
+        return false;
+      return true;
+    }
+
     template <typename T>
     class argument_template {
     public:
@@ -62,7 +432,8 @@ namespace arg {
       T const& get() const noexcept { return value; }
 
     protected:
-      T value;
+      // mutable, because a lazily converted value is stored on access
+      mutable T value;
     };
 
     class command_line_impl;
@@ -74,8 +445,13 @@ namespace arg {
        *
        * Takes a command line private API instance. That instance allows to
        * iterate over a vector and check, if the string is an argument.
+       * Returns an error code instead of throwing an exception.
+       *
+       * It used to return `void`: an override shall return
+       * `parse_errc::ok` on success. It may still throw `argument_error`,
+       * the error gets a name of the option.
        */
-      virtual void parse(command_line_impl& cmdline) = 0;
+      virtual parse_errc parse(command_line_impl& cmdline) = 0;
 
       virtual ~argument() {};
     };
@@ -93,249 +469,1044 @@ namespace arg {
       std::string_view description() const noexcept { return desc; }
 
       bool check_prefix(bool has_prefix) const noexcept {
-        if ((has_prefix && p_policy == prefix_policy::do_not_require) ||
-            (!has_prefix && p_policy == prefix_policy::require))
-          return false;
-        return true;
+        return details::check_prefix(p_policy, has_prefix);
       }
 
       void add_description(std::string_view description) {
         desc = description;
       }
-    protected:
-      std::string_view lname;
-      std::string_view sname;
-      std::string_view desc;
-      prefix_policy p_policy;
-    };
 
-    class command_line_impl {
-    public:
-      using svvec_t = std::vector<std::string_view>;
+      /*
+       * Returns true, if the argument takes a value, i.e. it may be given
+       * as `--name=value` or `-nvalue`.
+       */
+      virtual bool takes_value() const noexcept { return false; }
 
-      command_line_impl(std::string_view longname_start,
-                        std::string_view shortname_start) {
-        lname_prefix = longname_start;
-        sname_prefix = shortname_start;
-      }
+      /*
+       * Reserves a storage for `count` more values. Called before parsing,
+       * if a command line counts options in advance.
+       */
+      virtual void reserve(std::size_t count) { (void) count; }
 
       /*
-       * Parses a vector of arguments.
-       *
-       * In a `while` loop goes through the vector, and tries to find each
-       * string in an `args` dictionary. If the current string is found, i.e it
-       * is a named argument, then calls its `parse` method.
-       *
-       * Otherwise, if current string is not found, checks if there are
-       * positional arguments. If so, assigns current string to a positional
-       * argument and increments a counter of positional arguments.
-       *
-       * If the string is not found in a dictionary, and a count of positional
-       * arguments == `positional_args.size()`, then throws an error.
-       *
-       * May throw exception of type `argument_error`;
-       *
-       * If current positional arg iterator != positional args vector's end and
-       * there is a least one mandatory argument remained, then throws
-       * exception `argument_error`.
+       * Converts values, which conversion has been deferred by a lazy
+       * parse. Returns the first conversion error.
        */
-      inline void parse(svvec_t::const_iterator begin,
-                        svvec_t::const_iterator end) {
-        if (parsing_active)
-          throw command_line_error(
-              "command_line_impl::parse called recursively");
-        parsing_active = true;
+      virtual parse_status validate() { return {}; }
 
-        try {
-          current = begin;
-          this->end = end;
-          cur_pos_arg = p_args.begin();
-
-          while (current != end) {
-            auto arg_data = remove_prefix(*current);
-            auto arg = arg_data.first;
-            bool has_prefix = arg_data.second;
-            auto it = args.find(arg);
-
-            if (!arg_at(it).check_prefix(has_prefix))
-              throw argument_error("Prefix error", *current);
-
-            std::string_view last_arg = *current;
-            try {
-              if (it != args.end()) {
-                arg_at(it).parse(*this);
-              } else if (cur_pos_arg != p_args.end()) {
-                cur_pos_arg->get().parse(*this);
-                ++cur_pos_arg;
-              } else throw argument_error("Unrecognized argument");
-            } catch (argument_error const& e) {
-              throw argument_error(e.what(), last_arg);
-            }
-            if (!parsing_active) return;
-            ++current;
-          }
+      /*
+       * Hands over values, which are kept by the argument. Called after
+       * each parse, even one stopped by an exception, if the argument is
+       * registered with `flush_after_parse`.
+       */
+      virtual void flush() {}
 
-          while (cur_pos_arg != p_args.end()) {
-            if (cur_pos_arg->is_mandatory())
-              throw argument_error("Positional argument required");
-          }
-        } catch (...) {
-          parsing_active = false;
-          throw;
-        }
-        parsing_active = false;
-      }
+      /*
+       * Clears a state of the previous parse. Called at the start of each
+       * parse.
+       */
+      virtual void begin_parse() noexcept {}
 
       /*
-       * Checks if `s` is an argument.
-       *
-       * Removes a prefix, if it is found in `s`, and finds the resulting
-       * string in an args dictionary. If an argument is found, then `s` is an
-       * argument name.
+       * Gives a boolean value of the environment or a config file to an
+       * argument, which takes no value. By default a true value parses the
+       * argument once.
        */
-      bool is_argument(std::string_view s) {
-        auto name = remove_prefix(s).first;
-        if (args.find(name) != args.end()) return true;
-        return false;
+      virtual parse_errc parse_flag(command_line_impl& cmdline, bool on) {
+        return on ? parse(cmdline) : parse_errc::ok;
       }
 
       /*
-       * Checks, if `s` starts with longname or shortname prefix. If so,
-       * returns `std::string_view` without these first characters. Otherwise,
-       * returns `s` itself.
+       * Binds the argument to an environment variable, which supplies a
+       * value, if the argument is not given in a command line.
        */
-      std::pair<std::string_view, bool> remove_prefix(std::string_view s) {
-        bool starts_lname = starts_with(s, lname_prefix);
-        bool starts_sname = starts_with(s, sname_prefix);
-        if (starts_sname && !starts_lname) {
-          return { s.substr(sname_prefix.size()), true };
-        } else if (starts_lname) {
-          return { s.substr(lname_prefix.size()), true };
-        }
-        return { s, false };
-      }
+      void bind_env(std::string_view name) noexcept { env_name = name; }
 
       /*
-       * Checks if `str` starts with `subs`.
+       * Binds the argument to a key of a config file, which supplies a
+       * value, if the argument is given neither in a command line, nor in
+       * the environment. A key in a section is `section.key`.
        */
-      constexpr bool starts_with(std::string_view str, std::string_view subs) {
-        return str.substr(0, subs.size()) == subs;
-      }
+      void bind_config(std::string_view key) noexcept { config_key = key; }
+
+      std::string_view env_variable() const noexcept { return env_name; }
+
+      std::string_view config_name() const noexcept { return config_key; }
 
       /*
-       * Increments an input vector iterator and returns optional of the next
-       * argument. If an end of input vector is reached, then assigns to an
-       * input vector's pointer a null value. In the case if input vector is
-       * null, returns empty optional.
+       * Returns a layer, which has supplied a value in the last parse.
        */
-      std::optional<std::string_view> next_argument() {
-        if (parsing_active && ++current != end) { return *current; }
-        parsing_active = false;
-        return {};
-      }
+      value_source source() const noexcept { return src; }
+    protected:
+      std::string_view lname;
+      std::string_view sname;
+      std::string_view desc;
+      prefix_policy p_policy;
+      std::string_view env_name;
+      std::string_view config_key;
+      value_source src = value_source::none;
+
+      friend class command_line_impl;
+    };
+
+    using parse_handler = parse_errc (*)(named_argument&, command_line_impl&);
+
+    /*
+     * Calls `parse` of an argument through the type it was attached as.
+     * Arguments of the library declare `parse` final, so the call is not
+     * virtual and may be inlined.
+     */
+    template <class Argument>
+    parse_errc parse_as(named_argument& arg, command_line_impl& cmdline) {
+      return static_cast<Argument&>(arg).parse(cmdline);
+    }
+
+    /*
+     * Record of an attached argument, which the parse loop calls. Records
+     * are stored in one contiguous vector in the order of attaching, so an
+     * index from a names table refers to the record directly.
+     */
+    struct argument_handler {
+      named_argument* arg;
+      parse_handler parse;
+    };
+
+    /*
+     * Flat open addressing hash table, which maps argument names to indices.
+     *
+     * Built once by `command_line_impl::freeze` after all arguments are
+     * attached. Slots are stored in one contiguous vector, capacity is a power
+     * of two with a load factor not greater than 1/2, so a lookup usually
+     * touches a single slot. A stored hash is compared before a name, that
+     * is why strings are compared only on a probable match.
+     */
+    class name_index {
+    public:
+      static constexpr std::size_t npos = static_cast<std::size_t>(-1);
 
       /*
-       * Returns optional of the current argument's string_view. If an end of
-       * input vector is reached or input vector is null, then returns an empty
-       * optional.
+       * Drops all names and prepares the table for `count` insertions.
        */
-      std::optional<std::string_view> get_argument() {
-        if (parsing_active && current != end) { return *current; }
-        parsing_active = false;
-        return {};
+      void reset(std::size_t count) {
+        std::size_t capacity = 8;
+        while (capacity < count * 2) capacity *= 2;
+        slots.assign(capacity, slot {});
+        mask = capacity - 1;
+        longest = 0;
       }
 
       /*
-       * Attaches named argument
+       * Inserts `name` with index `id`. Empty names are not inserted. If the
+       * name is already in the table, the first inserted index is kept.
        */
-      void attach_argument(details::named_argument& arg) {
-        args.insert({ arg.longname(), arg });
-        args.insert({ arg.shortname(), arg });
-        args_list.push_back(arg);
+      void insert(std::string_view name, std::size_t id) {
+        if (name.empty()) return;
+        longest = std::max(longest, name.size());
+        auto const h = hash(name);
+        for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+          slot& sl = slots[i];
+          if (sl.id == empty_id) {
+            sl = slot { name, h, static_cast<std::uint32_t>(id) };
+            return;
+          }
+          if (sl.hash == h && sl.name == name) return;
+        }
       }
 
       /*
-       * Attaches positional argument. Positional arguments have no names and
-       * they are identified only by its position in the vector `p_args`.
+       * Returns an index of `name` or `npos`, if the name is not found. A
+       * string longer than all names is not hashed, so long values are
+       * rejected at once.
        */
-      void attach_argument(details::argument& arg, bool arg_mandatory) {
-        if (!p_args.empty()) {
-          bool prev_arg_necessarity = p_args.front().is_mandatory();
-          if (!prev_arg_necessarity && arg_mandatory)
-            throw command_line_error("Mandatory positional argument can not "
-                                     "follow the not mandatory");
+      std::size_t find(std::string_view name) const noexcept {
+        if (slots.empty() || name.size() > longest) return npos;
+        auto const h = hash(name);
+        for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+          slot const& sl = slots[i];
+          if (sl.id == empty_id) return npos;
+          if (sl.hash == h && sl.name == name) return sl.id;
         }
-        p_args.emplace_back(arg, arg_mandatory);
       }
 
-      template <class Iterator>
-      named_argument& arg_at(Iterator it) const noexcept {
-        return it->second.get();
+      /*
+       * FNV-1a hash, folded to 32 bits. Argument names are short, so a
+       * simple byte-wise hash is faster here than a general purpose one.
+       */
+      static std::uint32_t hash(std::string_view s) noexcept {
+        std::uint64_t h = 14695981039346656037ull;
+        for (unsigned char c : s) {
+          h ^= c;
+          h *= 1099511628211ull;
+        }
+        return static_cast<std::uint32_t>(h ^ (h >> 32));
       }
 
-      std::vector<std::string> description() const {
-        std::vector<std::string> vec;
-        vec.reserve(args_list.size());
+    private:
+      static constexpr std::uint32_t empty_id = static_cast<std::uint32_t>(-1);
+
+      struct slot {
+        std::string_view name;
+        std::uint32_t hash = 0;
+        std::uint32_t id = empty_id;
+      };
 
-        std::string_view delim = ", ";
-        const int lefthand_side_length = 30;
+      std::vector<slot> slots;
+      std::size_t mask = 0;
+      std::size_t longest = 0;
+    };
 
-        auto calculate_size = [&](named_argument const& arg, bool has_prefix) {
-          auto prefix_total = lname_prefix.size() + sname_prefix.size();
-          auto name_size =
-              arg.shortname().size() + arg.longname().size() + delim.size();
-          return arg.check_prefix(has_prefix) ? name_size + prefix_total
-                                              : name_size;
-        };
+    struct attached_match {
+      std::size_t id;
+      std::string_view value;
+    };
 
-        for (auto const& it : args_list) {
-          named_argument const& arg = it.get();
-          bool has_prefix = arg.check_prefix(true);
-          int argnames_length = calculate_size(arg, has_prefix);
-          int description_delimiter = lefthand_side_length - argnames_length;
+    /*
+     * Splits an argument `s` into an option name and a value attached to it:
+     * `--name=value`, `-n=value` or, if `takes_value(id)` is true for a one
+     * character short name, `-nvalue`. `name` is `s` without a prefix,
+     * `find(name)` returns an option index or `name_index::npos`. The value
+     * is a view of `s`. If the name is not found, `id` is `name_index::npos`.
+     *
+     * All front-ends split attached values with this function.
+     */
+    template <class Find, class TakesValue>
+    attached_match split_attached(std::string_view s, std::string_view name,
+                                  std::string_view lname_prefix, Find&& find,
+                                  TakesValue&& takes_value) {
+      if (name.empty()) return { name_index::npos, {} };
+
+      auto eq = name.find('=');
+      if (eq != std::string_view::npos) {
+        std::size_t id = find(name.substr(0, eq));
+        if (id != name_index::npos) return { id, name.substr(eq + 1) };
+      }
 
-          if (description_delimiter > 0)
-            vec.emplace_back(lefthand_side_length + arg.description().size(),
-                             '\0');
-          else
-            vec.emplace_back(lefthand_side_length + argnames_length +
-                                 arg.description().size() + 1,
-                             '\0');
+      if (name.size() > 1 && !starts_with(s, lname_prefix)) {
+        std::size_t id = find(name.substr(0, 1));
+        if (id != name_index::npos && takes_value(id))
+          return { id, name.substr(1) };
+      }
+      return { name_index::npos, {} };
+    }
 
-          std::string& s = vec.back();
+    /*
+     * Splits a bundle of one character short names `chars`, which is `-abc`
+     * without a prefix. `find_short(c)` returns an option index or
+     * `name_index::npos`. An option taking a value ends the bundle and gets
+     * the rest of it or, if it is the last character, nothing.
+     * `on_option(id, rest)` handles each option and returns false to stop.
+     * Returns false, if `chars` is not a bundle; in that case `on_option` is
+     * not called.
+     *
+     * All front-ends split bundles with this function.
+     */
+    template <class FindShort, class TakesValue, class OnOption>
+    bool split_bundle(std::string_view chars, FindShort&& find_short,
+                      TakesValue&& takes_value, OnOption&& on_option) {
+      if (chars.size() < 2) return false;
+      for (char c : chars) {
+        std::size_t id = find_short(c);
+        if (id == name_index::npos) return false;
+        if (takes_value(id)) break;
+      }
 
-          if (!arg.shortname().empty()) {
-            if (has_prefix) s.append(sname_prefix);
-            s.append(arg.shortname()).append(delim);
-          }
-          if (!arg.longname().empty()) {
-            if (has_prefix) s.append(lname_prefix);
-            s.append(arg.longname());
-          }
+      for (std::size_t i = 0; i < chars.size(); ++i) {
+        std::size_t id = find_short(chars[i]);
+        bool last = takes_value(id);
+        std::optional<std::string_view> rest;
+        if (last && i + 1 < chars.size()) rest = chars.substr(i + 1);
+        if (!on_option(id, rest) || last) break;
+      }
+      return true;
+    }
 
-          if (description_delimiter > 0) s.append(description_delimiter, ' ');
-          else s.append("\n").append(lefthand_side_length, ' ');
+    /*
+     * Argument names with long and short name prefixes. Finds an argument
+     * index by a command line string. A lookup does not modify the table, so
+     * a filled table can be shared between threads.
+     */
+    class name_table {
+    public:
+      struct match {
+        std::size_t id;
+        bool has_prefix;
+      };
 
-          s.append(arg.description());
-        }
+      name_table(std::string_view lname_prefix, std::string_view sname_prefix)
+          : lname_prefix(lname_prefix), sname_prefix(sname_prefix) {}
 
-        return vec;
+      void reset(std::size_t count) {
+        index.reset(count);
+        short_ids.fill(no_short);
       }
 
-      void stop() noexcept { parsing_active = false; }
-
-      std::pair<svvec_t::const_iterator, svvec_t::const_iterator>
-          get_arg_iterator() const noexcept {
-        return { current, end };
+      void insert(std::string_view name, std::size_t id) {
+        index.insert(name, id);
       }
 
-    private:
-      struct posarg_wrapper {
-      public:
-        posarg_wrapper(argument& arg, bool mandatory) noexcept
-            : arg(arg), mandatory(mandatory) {}
+      /*
+       * Inserts a short name. A one character name also goes to a direct
+       * table, which resolves bundles of short names `-abc`.
+       */
+      void insert_short(std::string_view name, std::size_t id) {
+        index.insert(name, id);
+        if (name.size() != 1) return;
+        auto& slot = short_ids[static_cast<unsigned char>(name[0])];
+        if (slot == no_short) slot = static_cast<std::uint32_t>(id);
+      }
 
-        argument& get() const noexcept { return arg.get(); }
+      /*
+       * Returns an id of an option, which short name is `c`, or
+       * `name_index::npos`.
+       */
+      std::size_t find_short(char c) const noexcept {
+        std::uint32_t id = short_ids[static_cast<unsigned char>(c)];
+        return id == no_short ? name_index::npos : id;
+      }
+
+      /*
+       * Returns characters of `s` after a short name prefix, if `s` starts
+       * with the short prefix and not with the long one, otherwise returns
+       * an empty view.
+       */
+      std::string_view short_names(std::string_view s) const noexcept {
+        auto [name, has_prefix] = remove_prefix(s);
+        if (!has_prefix || starts_with(s, lname_prefix)) return {};
+        return name;
+      }
+
+      /*
+       * Removes a prefix from `s` and finds the rest in an index. If the
+       * name is not found, `match::id` is `name_index::npos`.
+       */
+      match find(std::string_view s) const noexcept {
+        auto [name, has_prefix] = remove_prefix(s);
+        return { index.find(name), has_prefix };
+      }
+
+      std::pair<std::string_view, bool>
+          remove_prefix(std::string_view s) const noexcept {
+        return details::remove_prefix(s, lname_prefix, sname_prefix);
+      }
+
+      /*
+       * Splits an argument into an option name and an attached value, see
+       * `details::split_attached`. If `s` has no prefix, `id` is
+       * `name_index::npos`.
+       */
+      template <class TakesValue>
+      attached_match find_attached(std::string_view s,
+                                   TakesValue&& takes_value) const {
+        auto [name, has_prefix] = remove_prefix(s);
+        if (!has_prefix) return { name_index::npos, {} };
+        return split_attached(
+            s, name, lname_prefix,
+            [this](std::string_view n) { return index.find(n); },
+            takes_value);
+      }
+
+      std::string_view long_prefix() const noexcept { return lname_prefix; }
+
+      std::string_view short_prefix() const noexcept { return sname_prefix; }
+
+    private:
+      static constexpr std::uint32_t no_short = ~std::uint32_t(0);
+
+      name_index index;
+      std::array<std::uint32_t, 256> short_ids;
+      std::string_view lname_prefix;
+      std::string_view sname_prefix;
+    };
+
+    /*
+     * Functions, which give access to elements of an arguments source. The
+     * source is any sequence, the position is an opaque number: an index of
+     * an array element or an offset in a buffer.
+     *
+     * A single pass source, like a stream, is read while it is advanced, so
+     * it can not be scanned in advance and only a few recent elements are
+     * accessible. Reading may throw, and `failed` returns true, if the
+     * source has ended because of a read error.
+     */
+    struct cursor_source {
+      std::string_view (*fetch)(void const* source, std::size_t pos) noexcept;
+      std::size_t (*advance)(void const* source, std::size_t pos);
+      bool single_pass = false;
+      bool (*failed)(void const* source) noexcept = nullptr;
+    };
+
+    template <typename T>
+    std::string_view fetch_element(void const* source,
+                                   std::size_t pos) noexcept {
+      return std::string_view(static_cast<T const*>(source)[pos]);
+    }
+
+    inline std::size_t next_element(void const*, std::size_t pos) noexcept {
+      return pos + 1;
+    }
+
+    /*
+     * Source of an array of `char*`, `char const*`, `std::string` or
+     * `std::string_view`. A length of a C string is computed only when the
+     * element is accessed.
+     */
+    template <typename T>
+    inline constexpr cursor_source array_source { &fetch_element<T>,
+                                                  &next_element };
+
+    /*
+     * Forward iterator over command line arguments, which does not depend
+     * on a type of an arguments container. Dereferencing returns a
+     * `std::string_view` of the current argument.
+     */
+    class arg_cursor {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = std::string_view;
+
+      arg_cursor() noexcept = default;
+
+      arg_cursor(void const* source, std::size_t pos,
+                 cursor_source const& ops) noexcept
+          : source(source), pos(pos), ops(&ops) {}
+
+      std::string_view operator*() const noexcept {
+        return ops->fetch(source, pos);
+      }
+
+      arg_cursor& operator++() {
+        pos = ops->advance(source, pos);
+        return *this;
+      }
+
+      arg_cursor operator++(int) {
+        arg_cursor tmp = *this;
+        ++*this;
+        return tmp;
+      }
+
+      bool operator==(arg_cursor const& other) const noexcept {
+        return pos == other.pos && source == other.source;
+      }
+
+      bool operator!=(arg_cursor const& other) const noexcept {
+        return !(*this == other);
+      }
+
+      std::size_t position() const noexcept { return pos; }
+
+      bool single_pass() const noexcept { return ops && ops->single_pass; }
+
+      /*
+       * Returns true, if a source has ended because of a read error.
+       */
+      bool failed() const noexcept {
+        return ops && ops->failed && ops->failed(source);
+      }
+
+    private:
+      void const* source = nullptr;
+      std::size_t pos = 0;
+      cursor_source const* ops = nullptr;
+    };
+
+    /*
+     * Makes a pair of cursors over an array of `size` elements.
+     */
+    template <typename T>
+    std::pair<arg_cursor, arg_cursor> make_cursors(T const* data,
+                                                   std::size_t size) noexcept {
+      return { arg_cursor(data, 0, array_source<T>),
+               arg_cursor(data, size, array_source<T>) };
+    }
+
+    /*
+     * What the parse loop knows about an option, besides its names.
+     */
+    struct option_traits {
+      prefix_policy prefix = prefix_policy::optional;
+      bool takes_value = false;
+    };
+
+    /*
+     * Frozen names of options with their traits, indexed by an option id.
+     * The table is built once, after all options are known, and parsing
+     * only reads it, so one table serves parses on several threads.
+     */
+    class option_table {
+    public:
+      option_table(std::string_view lname_prefix,
+                   std::string_view sname_prefix)
+          : table(lname_prefix, sname_prefix) {}
+
+      /*
+       * Drops all options and prepares the table for `count` of them.
+       */
+      void reset(std::size_t count) {
+        table.reset(count * 2);
+        options.clear();
+        options.reserve(count);
+      }
+
+      /*
+       * Adds an option, which id is a number of options added before it.
+       * An option without names, like a positional one, is only counted.
+       */
+      void add(std::string_view longname, std::string_view shortname,
+               option_traits traits) {
+        std::size_t id = options.size();
+        table.insert(longname, id);
+        table.insert_short(shortname, id);
+        options.push_back(traits);
+      }
+
+      option_traits const& operator[](std::size_t id) const noexcept {
+        return options[id];
+      }
+
+      name_table const& names() const noexcept { return table; }
+
+    private:
+      name_table table;
+      std::vector<option_traits> options;
+    };
+
+    /*
+     * State of one parse: a position in arguments and the option, which is
+     * being parsed. The parse loop and option parsers advance it, so it is
+     * never shared between parses.
+     */
+    struct parse_state {
+      arg_cursor current;
+      arg_cursor end;
+      // the current argument and its position
+      std::string_view token;
+      std::size_t index = 0;
+      // a value attached to the option, it is consumed by the option
+      std::optional<std::string_view> attached;
+      // an argument, which names the option, and its position
+      std::string_view option;
+      std::size_t option_index = 0;
+      // a value given to the option, it is reported, if it is invalid
+      std::string_view last_value;
+      // false stops the loop
+      bool active = false;
+
+      /*
+       * Moves to the next argument and returns it. At the end of arguments
+       * returns nothing and stops the loop.
+       */
+      std::optional<std::string_view> next() {
+        if (active && ++current != end) {
+          ++index;
+          token = *current;
+          return token;
+        }
+        active = false;
+        return {};
+      }
+
+      /*
+       * Returns an error `code` of the current option.
+       */
+      parse_error error(parse_errc code) const noexcept {
+        std::string_view value;
+        if (code == parse_errc::invalid_value) value = last_value;
+        return { code, option, option_index, value };
+      }
+    };
+
+    /*
+     * Parse loop of `command_line` and `schema`. Goes through arguments of
+     * `st` from its current position and finds each of them in `table` as
+     * an option, an option with an attached value or a bundle of short
+     * names. Everything else is a positional argument. `parser` parses
+     * options and positional arguments of the front-end:
+     *
+     * - `find(token)` finds an argument in `table.names()`;
+     * - `parse_option(id)` parses an option, its attached value is in
+     *   `st.attached` and must be consumed;
+     * - `parse_positional()` parses `st.token` as the next positional
+     *   argument or returns `unrecognized_argument`;
+     * - `positional_missing()` returns true, if a mandatory positional
+     *   argument is not given;
+     * - `make_error(code)` returns an error of the current option.
+     *
+     * The loop ends at the end of arguments, on an error or when `st` is
+     * stopped. If a source has ended because of a read error, it is the
+     * error of the parse.
+     */
+    template <class Parser>
+    parse_status parse_loop(option_table const& table, parse_state& st,
+                            Parser& parser) {
+      name_table const& names = table.names();
+      auto takes_value = [&table](std::size_t id) {
+        return table[id].takes_value;
+      };
+
+      while (st.current != st.end) {
+        st.token = *st.current;
+        st.attached.reset();
+        auto [id, has_prefix] = parser.find(st.token);
+        if (id == name_index::npos) {
+          auto match = names.find_attached(st.token, takes_value);
+          if (match.id != name_index::npos) {
+            id = match.id;
+            has_prefix = true;
+            st.attached = match.value;
+          }
+        }
+
+        st.option = st.token;
+        st.option_index = st.index;
+        parse_errc code = parse_errc::ok;
+        auto parse_short = [&](std::size_t id,
+                               std::optional<std::string_view> rest) {
+          if (!check_prefix(table[id].prefix, true)) {
+            code = parse_errc::prefix_error;
+            return false;
+          }
+          st.attached = rest;
+          code = parser.parse_option(id);
+          return code == parse_errc::ok && st.active;
+        };
+
+        if (id != name_index::npos) {
+          if (!check_prefix(table[id].prefix, has_prefix))
+            code = parse_errc::prefix_error;
+          else code = parser.parse_option(id);
+          if (code == parse_errc::ok && st.attached)
+            code = parse_errc::unexpected_value;
+        } else if (split_bundle(names.short_names(st.token),
+                                [&names](char c) {
+                                  return names.find_short(c);
+                                },
+                                takes_value, parse_short)) {
+        } else code = parser.parse_positional();
+
+        if (st.end.failed()) break;
+        if (code != parse_errc::ok) return parser.make_error(code);
+        if (!st.active) return {};
+        ++st.current;
+        ++st.index;
+      }
+
+      if (st.end.failed())
+        return parse_error { parse_errc::read_error, {}, st.index, {} };
+      if (parser.positional_missing())
+        return parse_error { parse_errc::positional_required, {}, st.index,
+                             {} };
+      return {};
+    }
+
+    /*
+     * Argument, which keeps values in an arena of a command line.
+     */
+    class arena_storage {
+    public:
+      /*
+       * Drops all values. Called before the arena is released, so values
+       * must not be accessed after that.
+       */
+      virtual void drop_values() noexcept = 0;
+
+    protected:
+      ~arena_storage() = default;
+    };
+
+    class command_line_impl {
+    public:
+      using svvec_t = std::vector<std::string_view>;
+      using environment_fn = char** (*)() noexcept;
+
+      command_line_impl(std::string_view longname_start,
+                        std::string_view shortname_start)
+          : table(longname_start, shortname_start) {}
+
+      /*
+       * Calls `f`, measuring it as a `phase` of parsing, if instrumentation
+       * is enabled. Otherwise, only calls `f`.
+       */
+      template <class F>
+      decltype(auto) measure(parse_phase phase, conversion_kind kind,
+                             std::string_view token, F&& f) const {
+#if ARGUEME_INSTRUMENT
+        return probe.measure(phase, kind, token, std::forward<F>(f));
+#else
+        (void) phase;
+        (void) kind;
+        (void) token;
+        return f();
+#endif
+      }
+
+      /*
+       * Parses a vector of arguments.
+       *
+       * In a `while` loop goes through the vector, and tries to find each
+       * string in a names index. If the current string is found, i.e it is a
+       * named argument, then calls its `parse` method. The loop is
+       * `details::parse_loop`, which is shared with `schema`.
+       *
+       * Otherwise, if current string is not found, checks if there are
+       * positional arguments. If so, assigns current string to a positional
+       * argument and increments a counter of positional arguments.
+       *
+       * If the string is not found in a dictionary, and a count of positional
+       * arguments == `positional_args.size()`, then returns an error.
+       *
+       * If current positional arg iterator != positional args vector's end and
+       * there is a least one mandatory argument remained, then returns an
+       * error.
+       *
+       * Errors are returned as `parse_error`, nothing is allocated for them.
+       * Exceptions, thrown by commands, are passed through.
+       *
+       * Freezes the command line, if it is not frozen yet.
+       */
+      inline parse_status try_parse(arg_cursor begin, arg_cursor end) {
+        if (state.active)
+          throw command_line_error(
+              "command_line_impl::parse called recursively");
+        freeze();
+        state.active = true;
+
+        parse_status status;
+        try {
+          release_arena();
+          for (named_argument& arg : args_list) {
+            arg.src = value_source::none;
+            arg.begin_parse();
+          }
+          if (count_values && !begin.single_pass())
+            reserve_values(begin, end);
+          status = parse_arguments(begin, end);
+          if (status && (env_enabled || !config_text.empty()))
+            status = resolve_layers();
+        } catch (argument_error const& e) {
+          // an error of a command or a custom argument gets a name of the
+          // option, which has raised it
+          state.active = false;
+#if ARGUEME_INSTRUMENT
+          probe.error(state.token);
+#endif
+          flush_arguments();
+          throw argument_error(e.what(), state.option);
+        } catch (...) {
+          state.active = false;
+#if ARGUEME_INSTRUMENT
+          probe.error(state.token);
+#endif
+          flush_arguments();
+          throw;
+        }
+        state.active = false;
+        flush_arguments();
+#if ARGUEME_INSTRUMENT
+        if (!status) probe.error(status.error().token);
+#endif
+        return status;
+      }
+
+      /*
+       * Same as `try_parse`, but throws `argument_error` on an error.
+       */
+      inline void parse(arg_cursor begin, arg_cursor end) {
+        parse_status status = try_parse(begin, end);
+        if (!status) throw_parse_error(status.error());
+      }
+
+      /*
+       * Builds a names index over long and short names of all attached
+       * arguments. Called by `parse` automatically, attaching a new argument
+       * drops the index.
+       */
+      void freeze() {
+        if (frozen) return;
+        table.reset(args_list.size());
+        for (named_argument const& arg : args_list) {
+          // an argument is constructed completely by now, so its final
+          // `takes_value` is called
+          table.add(arg.longname(), arg.shortname(),
+                    { arg.p_policy, arg.takes_value() });
+        }
+        frozen = true;
+      }
+
+      bool is_frozen() const noexcept { return frozen; }
+
+      /*
+       * Checks if `s` is an argument.
+       *
+       * Removes a prefix, if it is found in `s`, and finds the resulting
+       * string in a names index. If an argument is found, then `s` is an
+       * argument name.
+       */
+      bool is_argument(std::string_view s) {
+        freeze();
+        return measure(parse_phase::lookup, {}, s, [&] {
+          return names().find(s).id != name_index::npos;
+        });
+      }
+
+      /*
+       * Checks, if `s` starts with longname or shortname prefix. If so,
+       * returns `std::string_view` without these first characters. Otherwise,
+       * returns `s` itself.
+       */
+      std::pair<std::string_view, bool> remove_prefix(std::string_view s) {
+        return measure(parse_phase::remove_prefix, {}, s,
+                       [&] { return names().remove_prefix(s); });
+      }
+
+      /*
+       * Converts a value of an argument with `util::try_from_string`.
+       */
+      template <typename T>
+      bool convert(std::string_view s, T& res) {
+        return measure(parse_phase::conversion, conversion_kind_of<T>(), s,
+                       [&] { return util::try_from_string(s, res); });
+      }
+
+#if ARGUEME_INSTRUMENT
+      parse_stats stats() const { return probe.snapshot(); }
+
+      void reset_stats() { probe.reset(); }
+
+      void observe(parse_observer observer) {
+        probe.observe(std::move(observer));
+      }
+#endif
+
+      /*
+       * Increments an input vector iterator and returns optional of the next
+       * argument. If an end of input vector is reached, then assigns to an
+       * input vector's pointer a null value. In the case if input vector is
+       * null, returns empty optional.
+       */
+      std::optional<std::string_view> next_argument() {
+        return state.next();
+      }
+
+      /*
+       * Returns optional of a value of the current option: a value attached
+       * to the option name or the next argument, if it is not an option
+       * name. An attached value is not checked.
+       */
+      std::optional<std::string_view> next_value() {
+        if (state.attached) {
+          state.last_value = *state.attached;
+          state.attached.reset();
+          return state.last_value;
+        }
+        auto s = next_argument();
+        if (!s || is_argument(*s)) return {};
+        state.last_value = *s;
+        return s;
+      }
+
+      /*
+       * Returns optional of the current argument's string_view. If an end of
+       * input vector is reached or input vector is null, then returns an empty
+       * optional.
+       */
+      std::optional<std::string_view> get_argument() {
+        if (state.active && state.current != state.end) {
+          state.last_value = state.token;
+          return state.token;
+        }
+        state.active = false;
+        return {};
+      }
+
+      /*
+       * Returns a monotonic arena, which is released at the start of each
+       * parse, and registers `user` to drop its values before that.
+       */
+      std::pmr::memory_resource* attach_arena(arena_storage& user) {
+        if (!arena)
+          arena = std::make_unique<std::pmr::monotonic_buffer_resource>();
+        arena_users.push_back(&user);
+        return arena.get();
+      }
+
+      void flush_after_parse(named_argument& arg) { flushed.push_back(&arg); }
+
+      /*
+       * Enables counting of options before parsing, so each argument
+       * reserves a storage for its values once.
+       */
+      void reserve_values(bool enable) noexcept { count_values = enable; }
+
+      /*
+       * Enables the environment layer with `envp`, a null terminated array
+       * of `NAME=value` strings.
+       */
+      void use_environment(char** envp) noexcept {
+        env_enabled = true;
+        environment = envp;
+        environment_source = nullptr;
+      }
+
+      /*
+       * Enables the environment layer with an environment, which `source`
+       * returns on each parse.
+       */
+      void use_environment(environment_fn source) noexcept {
+        env_enabled = true;
+        environment = nullptr;
+        environment_source = source;
+      }
+
+      void use_config(std::string_view text) noexcept { config_text = text; }
+
+      /*
+       * Enables lazy conversion: arguments record values and convert them
+       * on access.
+       */
+      void lazy_conversion(bool enable) noexcept { lazy = enable; }
+
+      bool is_lazy() const noexcept { return lazy; }
+
+      /*
+       * Returns a deferred conversion of `value` of the current option. It
+       * is the error, which is reported, if the conversion fails.
+       */
+      parse_error defer(std::string_view value) const noexcept {
+        return { parse_errc::invalid_value, state.option, state.option_index,
+                 value };
+      }
+
+      /*
+       * Converts all deferred values. Returns the first conversion error.
+       */
+      parse_status validate() {
+        for (named_argument& arg : args_list) {
+          auto status = arg.validate();
+          if (!status) return status;
+        }
+        return {};
+      }
+
+      /*
+       * Attaches named argument. `parse` is called instead of a virtual
+       * `parse` of the argument.
+       */
+      void attach_argument(details::named_argument& arg,
+                           parse_handler parse = &parse_as<named_argument>) {
+        args_list.push_back(arg);
+        handlers.push_back({ &arg, parse });
+        frozen = false;
+        completion_ready = false;
+      }
+
+      /*
+       * Attaches positional argument. Positional arguments have no names and
+       * they are identified only by its position in the vector `p_args`.
+       */
+      void attach_argument(details::argument& arg, bool arg_mandatory) {
+        if (!p_args.empty()) {
+          bool prev_arg_necessarity = p_args.front().is_mandatory();
+          if (!prev_arg_necessarity && arg_mandatory)
+            throw command_line_error("Mandatory positional argument can not "
+                                     "follow the not mandatory");
+        }
+        p_args.emplace_back(arg, arg_mandatory);
+      }
+
+      named_argument& arg_at(std::size_t id) const noexcept {
+        return args_list[id].get();
+      }
+
+      std::vector<std::string> description() const {
+        return measure(parse_phase::help, {}, {},
+                       [this] { return render_description(); });
+      }
+
+      /*
+       * Returns a help text in a single buffer, which is cached, until
+       * arguments, their descriptions or `width` change.
+       */
+      std::string_view help(std::size_t width) const {
+        std::uint64_t key = help_key(width);
+        if (help_cached && key == help_cached_key) return help_text;
+        measure(parse_phase::help, {}, {},
+                [&] { return render_help(width); });
+        help_cached = true;
+        help_cached_key = key;
+        return help_text;
+      }
+
+      /*
+       * Appends names of arguments, which start with `partial`, to `out` in
+       * the lexicographical order. Names are found in a sorted index, which
+       * is built on the first query after arguments change.
+       */
+      void complete(std::string_view partial,
+                    std::vector<std::string_view>& out) const {
+        if (!completion_ready) build_completion();
+        auto it = std::lower_bound(completion_names.begin(),
+                                   completion_names.end(), partial);
+        for (; it != completion_names.end() && starts_with(*it, partial);
+             ++it)
+          out.push_back(*it);
+      }
+
+      std::string completion_script(completion_shell shell,
+                                    std::string_view program) const;
+
+      void stop() noexcept { state.active = false; }
+
+      /*
+       * Reports an error of a nested parse of the remaining arguments, for
+       * example by a subcommand. Its index is counted from the argument
+       * after the current one. Returns a code of the error.
+       */
+      parse_errc nested_error(parse_error const& e) {
+        nested = e;
+        nested->index += state.index + 1;
+        return e.code;
+      }
+
+      /*
+       * Keeps a function, which waits for a task of an asynchronous command,
+       * until `wait_tasks`.
+       */
+      void start_task(std::function<void()> wait) {
+        tasks.push_back(std::move(wait));
+      }
+
+      /*
+       * Waits for all started tasks, then rethrows the first exception of
+       * them.
+       */
+      void wait_tasks() {
+        std::exception_ptr error;
+        for (auto& wait : tasks) {
+          try {
+            wait();
+          } catch (...) {
+            if (!error) error = std::current_exception();
+          }
+        }
+        tasks.clear();
+        if (error) std::rethrow_exception(error);
+      }
+
+      std::pair<arg_cursor, arg_cursor> get_arg_iterator() const noexcept {
+        return { state.current, state.end };
+      }
+
+    private:
+      struct posarg_wrapper {
+      public:
+        posarg_wrapper(argument& arg, bool mandatory) noexcept
+            : arg(arg), mandatory(mandatory) {}
+
+        argument& get() const noexcept { return arg.get(); }
 
         bool is_mandatory() const noexcept { return mandatory; }
 
@@ -344,75 +1515,651 @@ namespace arg {
         bool const mandatory;
       };
 
-      bool parsing_active = false;
+      static constexpr std::size_t help_left_column = 30;
+
+      std::vector<std::string> render_description() const {
+        std::vector<std::string> vec;
+        vec.reserve(args_list.size());
+        for (auto const& it : args_list) {
+          named_argument const& arg = it.get();
+          std::string& s = vec.emplace_back();
+          s.reserve(help_left_column + help_names_size(arg) +
+                    arg.description().size() + 1);
+          render_argument(s, arg, 0);
+        }
+        return vec;
+      }
+
+      std::size_t help_names_size(named_argument const& arg) const noexcept {
+        return names().short_prefix().size() + arg.shortname().size() + 2 +
+               names().long_prefix().size() + arg.longname().size();
+      }
+
+      /*
+       * Appends a help line of `arg`: its names, padded to the left column,
+       * and a description, wrapped by words to `width` columns. Zero width
+       * disables wrapping. A word longer than a line is not broken.
+       */
+      void render_argument(std::string& s, named_argument const& arg,
+                           std::size_t width) const {
+        std::size_t const left = help_left_column;
+        std::size_t const start = s.size();
+        bool has_prefix = arg.check_prefix(true);
+        if (!arg.shortname().empty()) {
+          if (has_prefix) s.append(names().short_prefix());
+          s.append(arg.shortname()).append(", ");
+        }
+        if (!arg.longname().empty()) {
+          if (has_prefix) s.append(names().long_prefix());
+          s.append(arg.longname());
+        }
+
+        std::size_t names_length = s.size() - start;
+        if (names_length < left) s.append(left - names_length, ' ');
+        else s.append("\n").append(left, ' ');
+
+        std::string_view desc = arg.description();
+        if (width > left) {
+          std::size_t const line = width - left;
+          while (desc.size() > line) {
+            std::size_t cut = desc.rfind(' ', line);
+            if (cut == std::string_view::npos || cut == 0)
+              cut = desc.find(' ', line);
+            if (cut == std::string_view::npos) break;
+            s.append(desc.substr(0, cut)).append("\n").append(left, ' ');
+            desc.remove_prefix(cut);
+            while (!desc.empty() && desc.front() == ' ') desc.remove_prefix(1);
+          }
+        }
+        s.append(desc);
+      }
+
+      std::string_view render_help(std::size_t width) const {
+        help_text.clear();
+        std::size_t size = 0;
+        for (auto const& it : args_list)
+          size += help_left_column + help_names_size(it.get()) +
+                  it.get().description().size() + 2;
+        help_text.reserve(size + size / 8);
+        for (auto const& it : args_list) {
+          render_argument(help_text, it.get(), width);
+          help_text.push_back('\n');
+        }
+        return help_text;
+      }
+
+      /*
+       * Names of arguments as they are typed: with prefixes, unless the
+       * prefix policy is `do_not_require`, then without them.
+       */
+      template <class F>
+      void for_each_spelling(F&& f) const {
+        for (auto const& it : args_list) {
+          named_argument const& arg = it.get();
+          bool has_prefix = arg.check_prefix(true);
+          std::string name;
+          if (!arg.longname().empty()) {
+            if (has_prefix) name.append(names().long_prefix());
+            f(arg, name.append(arg.longname()), false);
+          }
+          name.clear();
+          if (!arg.shortname().empty()) {
+            if (has_prefix) name.append(names().short_prefix());
+            f(arg, name.append(arg.shortname()), true);
+          }
+        }
+      }
+
+      void build_completion() const {
+        completion_names.clear();
+        for_each_spelling([this](named_argument const&, std::string& name,
+                                 bool) { completion_names.push_back(name); });
+        std::sort(completion_names.begin(), completion_names.end());
+        completion_names.erase(std::unique(completion_names.begin(),
+                                           completion_names.end()),
+                               completion_names.end());
+        completion_ready = true;
+      }
+
+      /*
+       * Identifies a set of arguments and their descriptions, so a cached
+       * help text is rendered again, when it changes.
+       */
+      std::uint64_t help_key(std::size_t width) const noexcept {
+        std::uint64_t h = 14695981039346656037ull;
+        auto mix = [&h](std::uint64_t v) { h = (h ^ v) * 1099511628211ull; };
+        mix(width);
+        mix(args_list.size());
+        for (auto const& it : args_list) {
+          named_argument const& arg = it.get();
+          mix(reinterpret_cast<std::uintptr_t>(&arg));
+          mix(reinterpret_cast<std::uintptr_t>(arg.description().data()));
+          mix(arg.description().size());
+        }
+        return h;
+      }
+
+      struct layer_value {
+        std::string_view token;
+        std::string_view value;
+        value_source source = value_source::none;
+      };
+
+      /*
+       * Gives values of the environment and a config file to arguments,
+       * which are not given in a command line. The environment and the file
+       * are scanned once, names are found in hash tables of bound names.
+       */
+      parse_status resolve_layers() {
+        std::size_t const n = args_list.size();
+        name_index env_names, config_names;
+        env_names.reset(n);
+        config_names.reset(n);
+        for (std::size_t i = 0; i < n; ++i) {
+          named_argument const& arg = arg_at(i);
+          if (arg.src != value_source::none) continue;
+          env_names.insert(arg.env_name, i);
+          config_names.insert(arg.config_key, i);
+        }
+
+        std::vector<layer_value> values(n);
+        if (!config_text.empty()) scan_config(config_names, values);
+        if (env_enabled) scan_environment(env_names, values);
+
+        for (std::size_t i = 0; i < n; ++i) {
+          layer_value const& v = values[i];
+          if (v.source == value_source::none) continue;
+          named_argument& arg = arg_at(i);
+          state.option = v.token;
+          state.option_index = state.index;
+          parse_errc code = parse_errc::ok;
+          if (arg.takes_value()) {
+            state.attached = v.value;
+            code = arg.parse(*this);
+            state.attached.reset();
+          } else {
+            bool on = false;
+            state.last_value = v.value;
+            if (!util::try_from_string(v.value, on))
+              code = parse_errc::invalid_value;
+            else code = arg.parse_flag(*this, on);
+          }
+          if (code != parse_errc::ok) return state.error(code);
+          arg.src = v.source;
+        }
+        return {};
+      }
+
+      void scan_environment(name_index const& env_names,
+                            std::vector<layer_value>& values) const {
+        char** env = environment_source ? environment_source() : environment;
+        for (; env && *env; ++env) {
+          std::string_view entry { *env };
+          std::size_t eq = entry.find('=');
+          if (eq == std::string_view::npos) continue;
+          std::size_t id = env_names.find(entry.substr(0, eq));
+          if (id == name_index::npos) continue;
+          values[id] = { arg_at(id).env_name, entry.substr(eq + 1),
+                         value_source::environment };
+        }
+      }
+
+      /*
+       * Scans `key = value` lines of a config file. Lines in `[section]`
+       * have keys `section.key`, lines starting with `#` or `;` are
+       * comments. Values may be quoted with double quotes. If a key is
+       * repeated, the last value is taken.
+       */
+      void scan_config(name_index const& config_names,
+                       std::vector<layer_value>& values) const {
+        auto trim = [](std::string_view s) {
+          while (!s.empty() && is_space(s.front())) s.remove_prefix(1);
+          while (!s.empty() && is_space(s.back())) s.remove_suffix(1);
+          return s;
+        };
+
+        std::string_view text = config_text;
+        std::string_view section;
+        std::string key;
+        while (!text.empty()) {
+          std::size_t nl = text.find('\n');
+          std::string_view line = trim(text.substr(0, nl));
+          text.remove_prefix(nl == std::string_view::npos ? text.size()
+                                                          : nl + 1);
+          if (line.empty() || line.front() == '#' || line.front() == ';')
+            continue;
+          if (line.front() == '[') {
+            if (line.back() == ']')
+              section = trim(line.substr(1, line.size() - 2));
+            continue;
+          }
+          std::size_t eq = line.find('=');
+          if (eq == std::string_view::npos) continue;
+
+          std::string_view name = trim(line.substr(0, eq));
+          std::string_view value = trim(line.substr(eq + 1));
+          if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            value = value.substr(1, value.size() - 2);
+          if (!section.empty()) {
+            key.assign(section).append(".").append(name);
+            name = key;
+          }
+
+          std::size_t id = config_names.find(name);
+          if (id == name_index::npos) continue;
+          values[id] = { arg_at(id).config_key, value,
+                         value_source::config_file };
+        }
+      }
+
+      /*
+       * Hands over values kept by arguments, after any parse: a successful,
+       * a failed or an interrupted by an exception one.
+       */
+      void flush_arguments() {
+        for (named_argument* arg : flushed) arg->flush();
+      }
+
+      void release_arena() noexcept {
+        if (arena_users.empty()) return;
+        for (arena_storage* user : arena_users) user->drop_values();
+        arena->release();
+      }
+
+      /*
+       * Counts options in arguments and reserves a storage of each argument
+       * once. Bundles of short names are not counted.
+       */
+      void reserve_values(arg_cursor begin, arg_cursor end) {
+        occurrences.assign(args_list.size(), 0);
+        auto takes_value = [this](std::size_t i) {
+          return table[i].takes_value;
+        };
+        for (auto it = begin; it != end; ++it) {
+          std::string_view s = *it;
+          std::size_t id = names().find(s).id;
+          if (id == name_index::npos)
+            id = names().find_attached(s, takes_value).id;
+          if (id != name_index::npos) ++occurrences[id];
+        }
+        for (std::size_t i = 0; i < occurrences.size(); ++i)
+          if (occurrences[i] > 0) arg_at(i).reserve(occurrences[i]);
+      }
+
+      parse_status parse_arguments(arg_cursor begin, arg_cursor end) {
+        state.current = begin;
+        state.end = end;
+        state.index = 0;
+        cur_pos_arg = p_args.begin();
+        nested.reset();
+        return parse_loop(table, state, *this);
+      }
+
+      template <class Parser>
+      friend parse_status parse_loop(option_table const&, parse_state&,
+                                     Parser&);
+
+      name_table const& names() const noexcept { return table.names(); }
+
+      name_table::match find(std::string_view token) const {
+        return measure(parse_phase::lookup, {}, token,
+                       [&] { return names().find(token); });
+      }
+
+      parse_errc parse_option(std::size_t id) {
+        argument_handler const& h = handlers[id];
+        h.arg->src = value_source::command_line;
+        return h.parse(*h.arg, *this);
+      }
+
+      parse_errc parse_positional() {
+        if (cur_pos_arg == p_args.end())
+          return parse_errc::unrecognized_argument;
+        parse_errc code = cur_pos_arg->get().parse(*this);
+        ++cur_pos_arg;
+        return code;
+      }
+
+      bool positional_missing() const noexcept {
+        for (auto it = cur_pos_arg; it != p_args.end(); ++it)
+          if (it->is_mandatory()) return true;
+        return false;
+      }
+
+      parse_error make_error(parse_errc code) {
+        if (nested) {
+          parse_error e = *nested;
+          nested.reset();
+          return e;
+        }
+        return state.error(code);
+      }
+
+      bool frozen = false;
 
       using argument_t = std::reference_wrapper<named_argument>;
       using argsvec_t = std::vector<argument_t>;
 
-      typename svvec_t::const_iterator current;
-      typename svvec_t::const_iterator end;
+      parse_state state;
+      bool lazy = false;
 
       using pargsvec_t = std::vector<posarg_wrapper>;
       pargsvec_t p_args;
       typename pargsvec_t::const_iterator cur_pos_arg;
 
       std::vector<argument_t> args_list;
-      std::map<std::string_view, argument_t> args;
-
-      std::string_view lname_prefix;
-      std::string_view sname_prefix;
+      // built along with `args_list`
+      std::vector<argument_handler> handlers;
+      // built by `freeze`
+      option_table table;
+
+      std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+      std::vector<arena_storage*> arena_users;
+      std::vector<named_argument*> flushed;
+      bool count_values = false;
+      std::vector<std::size_t> occurrences;
+      std::vector<std::function<void()>> tasks;
+      std::optional<parse_error> nested;
+      bool env_enabled = false;
+      char** environment = nullptr;
+      environment_fn environment_source = nullptr;
+      std::string_view config_text;
+      mutable std::string help_text;
+      mutable std::uint64_t help_cached_key = 0;
+      mutable bool help_cached = false;
+      mutable std::vector<std::string> completion_names;
+      mutable bool completion_ready = false;
+#if ARGUEME_INSTRUMENT
+      mutable details::probe probe;
+#endif
     };
 
-    template <class C>
-    struct has_operator_extraction_impl {
-    private:
-      template <class T, std::istream& (std::istream::*) (T&) =
-                             (&std::istream::operator>>)>
-      struct wrapper {};
+    /*
+     * Quotes `s` with single quotes for bash and zsh.
+     */
+    inline std::string shell_quote(std::string_view s) {
+      std::string res { "'" };
+      for (char c : s) {
+        if (c == '\'') res.append("'\\''");
+        else res.push_back(c);
+      }
+      return res.append("'");
+    }
+
+    /*
+     * Quotes `s` with single quotes for fish, where `\` and `'` are escaped.
+     */
+    inline std::string fish_quote(std::string_view s) {
+      std::string res { "'" };
+      for (char c : s) {
+        if (c == '\'' || c == '\\') res.push_back('\\');
+        res.push_back(c);
+      }
+      return res.append("'");
+    }
 
-      template <class T>
-      static std::true_type check(wrapper<C>*);
+    inline std::string
+        command_line_impl::completion_script(completion_shell shell,
+                                             std::string_view program) const {
+      std::string fn { "_" };
+      for (char c : program) {
+        bool alnum = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                     (c >= '0' && c <= '9');
+        fn.push_back(alnum ? c : '_');
+      }
+      std::string prog = shell_quote(program);
+      std::string s;
+
+      switch (shell) {
+        case completion_shell::bash: {
+          std::string words;
+          for_each_spelling([&](named_argument const&, std::string& name,
+                                bool) {
+            if (!words.empty()) words.push_back(' ');
+            words.append(name);
+          });
+          s.append(fn).append("() {\n");
+          s.append("  local cur=\"${COMP_WORDS[COMP_CWORD]}\"\n");
+          s.append("  COMPREPLY=($(compgen -W ").append(shell_quote(words));
+          s.append(" -- \"$cur\"))\n}\n");
+          s.append("complete -o default -F ").append(fn).append(" ");
+          s.append(prog).append("\n");
+          break;
+        }
+        case completion_shell::zsh: {
+          s.append("#compdef ").append(program).append("\n");
+          s.append(fn).append("() {\n  local -a options\n  options=(\n");
+          for_each_spelling([&](named_argument const& arg, std::string& name,
+                                bool) {
+            std::string item;
+            for (char c : name) {
+              if (c == ':') item.push_back('\\');
+              item.push_back(c);
+            }
+            if (!arg.description().empty())
+              item.append(":").append(arg.description());
+            s.append("    ").append(shell_quote(item)).append("\n");
+          });
+          s.append("  )\n  _describe 'option' options\n}\n");
+          s.append("compdef ").append(fn).append(" ").append(prog);
+          s.append("\n");
+          break;
+        }
+        case completion_shell::fish: {
+          // fish knows `--long`, `-s` and `-old` options, other spellings
+          // are given as plain words
+          bool standard =
+              names().long_prefix() == "--" && names().short_prefix() == "-";
+          for (auto const& it : args_list) {
+            named_argument const& arg = it.get();
+            std::string line { "complete -c " };
+            line.append(fish_quote(program));
+            if (standard && arg.check_prefix(true)) {
+              if (!arg.longname().empty())
+                line.append(" -l ").append(fish_quote(arg.longname()));
+              if (arg.shortname().size() == 1)
+                line.append(" -s ").append(fish_quote(arg.shortname()));
+              else if (!arg.shortname().empty())
+                line.append(" -o ").append(fish_quote(arg.shortname()));
+              if (arg.takes_value()) line.append(" -r");
+            } else {
+              std::string words;
+              for (auto [name, prefix] :
+                   { std::pair { arg.longname(), names().long_prefix() },
+                     std::pair { arg.shortname(), names().short_prefix() } }) {
+                if (name.empty()) continue;
+                if (!words.empty()) words.push_back(' ');
+                if (arg.check_prefix(true)) words.append(prefix);
+                words.append(name);
+              }
+              line.append(" -f -a ").append(fish_quote(words));
+            }
+            if (!arg.description().empty())
+              line.append(" -d ").append(fish_quote(arg.description()));
+            s.append(line).append("\n");
+          }
+          break;
+        }
+      }
+      return s;
+    }
 
-      template <class T>
-      static std::false_type check(...);
-    public:
-      static constexpr bool value =
-          std::is_same_v<decltype(check<C>(0)), std::true_type>;
-    };
+    template <class C, class = void>
+    struct has_operator_extraction : std::false_type {};
 
     template <class C>
-    struct has_operator_extraction
-        : std::bool_constant<has_operator_extraction_impl<C>::value> {};
+    struct has_operator_extraction<
+        C, std::void_t<decltype(std::declval<std::istream&>() >>
+                                std::declval<C&>())>> : std::true_type {};
 
     template <class C>
     constexpr bool has_operator_extraction_v =
         has_operator_extraction<C>::value;
 
+    template <class C>
+    constexpr bool is_narrow_char_v =
+        std::is_same_v<C, char> || std::is_same_v<C, signed char> ||
+        std::is_same_v<C, unsigned char>;
+
+    [[noreturn]] inline void throw_conversion_error(std::string_view s) {
+      throw argument_error(conversion_message(s));
+    }
+
+    /*
+     * Converts an integer with an optional sign and an optional base prefix:
+     * `0x` for hexadecimal, `0b` for binary and `0o` for octal numbers.
+     * Returns false, if the whole string is not a valid number of type `T`.
+     */
+    template <typename T>
+    bool integer_from_chars(std::string_view s, T& res) noexcept {
+      using unsigned_t = std::make_unsigned_t<T>;
+
+      bool negative = false;
+      if (!s.empty() && (s.front() == '-' || s.front() == '+')) {
+        negative = s.front() == '-';
+        s.remove_prefix(1);
+      }
+      if (negative && std::is_unsigned_v<T>) return false;
+
+      int base = 10;
+      if (s.size() > 2 && s[0] == '0') {
+        switch (s[1]) {
+          case 'x':
+          case 'X': base = 16; break;
+          case 'b':
+          case 'B': base = 2; break;
+          case 'o':
+          case 'O': base = 8; break;
+        }
+        if (base != 10) s.remove_prefix(2);
+      }
+      // from_chars accepts a minus sign for signed types only
+      if (s.empty() || s.front() == '-' || s.front() == '+') return false;
+
+      unsigned_t magnitude = 0;
+      auto [ptr, ec] =
+          std::from_chars(s.data(), s.data() + s.size(), magnitude, base);
+      if (ec != std::errc {} || ptr != s.data() + s.size()) return false;
+
+      if constexpr (std::is_signed_v<T>) {
+        constexpr auto max = static_cast<unsigned_t>(
+            std::numeric_limits<T>::max());
+        if (magnitude > max + static_cast<unsigned_t>(negative)) return false;
+        res = negative ? static_cast<T>(0 - magnitude)
+                       : static_cast<T>(magnitude);
+      } else {
+        res = magnitude;
+      }
+      return true;
+    }
+
+    /*
+     * Converts a floating point number in a fixed or scientific notation,
+     * `inf` or `nan`, with an optional sign.
+     */
+    template <typename T>
+    bool float_from_chars(std::string_view s, T& res) noexcept {
+      if (!s.empty() && s.front() == '+') {
+        s.remove_prefix(1);
+        if (!s.empty() && s.front() == '-') return false;
+      }
+      if (s.empty()) return false;
+      T value {};
+      auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+      if (ec != std::errc {} || ptr != s.data() + s.size()) return false;
+      res = value;
+      return true;
+    }
+
+    /*
+     * Converts `true`, `yes`, `on`, `1` and `false`, `no`, `off`, `0`,
+     * case-insensitive.
+     */
+    inline bool bool_from_string(std::string_view s, bool& res) noexcept {
+      auto equals = [s](std::string_view word) {
+        if (s.size() != word.size()) return false;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+          char c = s[i];
+          if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+          if (c != word[i]) return false;
+        }
+        return true;
+      };
+      if (equals("1") || equals("true") || equals("yes") || equals("on")) {
+        res = true;
+        return true;
+      }
+      if (equals("0") || equals("false") || equals("no") || equals("off")) {
+        res = false;
+        return true;
+      }
+      return false;
+    }
+
+    /*
+     * Converts a string with `operator>>`. Used for types, which have no
+     * conversion without a stream.
+     */
+    template <typename T>
+    bool stream_from_string(std::string_view s, T& res) {
+      static_assert(details::has_operator_extraction_v<T>,
+                    "Type must have defined operator>>");
+      std::istringstream is(std::string { s });
+      T value;
+      is >> std::noskipws >> value;
+      if (is.fail() || is.peek() != EOF) return false;
+      res = std::move(value);
+      return true;
+    }
+
   } // namespace details
 
   namespace util {
 
+    /*
+     * Converts a string to a value of type `T` and assigns it to `res`.
+     * Returns false and leaves `res` unchanged, if the string is not a valid
+     * value.
+     *
+     * `std::string_view` refers to the same characters as `s`, a string
+     * keeps its allocator, so `std::pmr::string` is allocated in its memory
+     * resource. Arithmetic types are converted without allocations, other
+     * types are read with `operator>>`.
+     */
     template <typename T>
-    T from_string(std::string_view s) {
-      if constexpr (std::is_same_v<T, std::string> ||
-                    std::is_same_v<T, std::string_view>) {
-        return std::string { s };
+    bool try_from_string(std::string_view s, T& res) {
+      if constexpr (std::is_same_v<T, std::string_view>) {
+        res = s;
+        return true;
+      } else if constexpr (details::is_char_string_v<T>) {
+        res.assign(s);
+        return true;
+      } else if constexpr (std::is_same_v<T, bool>) {
+        return details::bool_from_string(s, res);
+      } else if constexpr (details::is_narrow_char_v<T>) {
+        if (s.size() != 1) return false;
+        res = static_cast<T>(s.front());
+        return true;
+      } else if constexpr (std::is_integral_v<T>) {
+        return details::integer_from_chars(s, res);
+      } else if constexpr (std::is_floating_point_v<T>) {
+        return details::float_from_chars(s, res);
       } else {
-        static_assert(details::has_operator_extraction_v<T>,
-                      "Type must have defined operator<<");
-        std::istringstream is(std::string { s });
-        T res;
-        is >> std::noskipws >> res;
-        if (is.fail() || is.peek() != EOF) {
-          std::string msg { "Cannot convert a string `" };
-          msg.append(s);
-          msg.append("` to a value");
-          throw argument_error(msg);
-        }
-        return res;
+        return details::stream_from_string(s, res);
       }
     }
 
+    /*
+     * Converts a string to a value of type `T`, same as `try_from_string`.
+     * Throws `argument_error`, if the string is not a valid value.
+     */
+    template <typename T>
+    T from_string(std::string_view s) {
+      T res {};
+      if (!try_from_string(s, res)) details::throw_conversion_error(s);
+      return res;
+    }
+
     template <class Functor, typename... Args>
     auto callable_wrapper(Functor f, Args&&... args) {
       return [f, &args...]() {
@@ -428,7 +2175,292 @@ namespace arg {
       execute(cmds...);
     }
 
-  } // namespace util
+  } // namespace util
+
+  namespace details {
+
+    inline unsigned count_trailing_zeros(unsigned mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long i;
+      _BitScanForward(&i, mask);
+      return static_cast<unsigned>(i);
+#else
+      return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+
+    inline unsigned count_ones(unsigned mask) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned n = 0;
+      for (; mask; mask &= mask - 1) ++n;
+      return n;
+#else
+      return static_cast<unsigned>(__builtin_popcount(mask));
+#endif
+    }
+
+    /*
+     * Returns a number of characters `c` in the first `n` characters of `p`.
+     */
+    inline std::size_t count_char(char const* p, std::size_t n,
+                                  char c) noexcept {
+      std::size_t i = 0;
+      std::size_t count = 0;
+#if ARGUEME_SIMD_AVX2
+      __m256i const needle = _mm256_set1_epi8(c);
+      for (; i + 32 <= n; i += 32) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+        count += count_ones(static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle))));
+      }
+#endif
+#if ARGUEME_SIMD_SSE2
+      __m128i const needle16 = _mm_set1_epi8(c);
+      for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        count += count_ones(static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle16))));
+      }
+#endif
+      for (; i < n; ++i) count += p[i] == c;
+      return count;
+    }
+
+    /*
+     * Splits `s` on `delim` and calls `f` with each piece, including empty
+     * ones. Stops and returns false, if `f` returns false. Delimiters are
+     * found 32 or 16 characters at once like in `find_special`, offsets in a
+     * block are taken from a bit mask.
+     */
+    template <typename F>
+    bool split(std::string_view s, char delim, F f) {
+      char const* p = s.data();
+      std::size_t n = s.size();
+      std::size_t start = 0;
+      std::size_t i = 0;
+      auto piece = [&](std::size_t end) {
+        std::size_t b = start;
+        start = end + 1;
+        return f(std::string_view(p + b, end - b));
+      };
+#if ARGUEME_SIMD_AVX2
+      __m256i const needle = _mm256_set1_epi8(delim);
+      for (; i + 32 <= n; i += 32) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, needle)));
+        for (; mask; mask &= mask - 1)
+          if (!piece(i + count_trailing_zeros(mask))) return false;
+      }
+#endif
+#if ARGUEME_SIMD_SSE2
+      __m128i const needle16 = _mm_set1_epi8(delim);
+      for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(v, needle16)));
+        for (; mask; mask &= mask - 1)
+          if (!piece(i + count_trailing_zeros(mask))) return false;
+      }
+#endif
+      for (; i < n; ++i)
+        if (p[i] == delim && !piece(i)) return false;
+      return piece(n);
+    }
+
+    /*
+     * Returns an offset of the first whitespace, quote or backslash in the
+     * first `n` characters of `p`, or `n`, if there are none. Scans 32 or 16
+     * characters at once with AVX2 or SSE2, if they are enabled at compile
+     * time, and one by one otherwise.
+     */
+    inline std::size_t find_special(char const* p, std::size_t n) noexcept {
+      std::size_t i = 0;
+#if ARGUEME_SIMD_AVX2
+      __m256i const space = _mm256_set1_epi8(' ');
+      __m256i const dquote = _mm256_set1_epi8('"');
+      __m256i const squote = _mm256_set1_epi8('\'');
+      __m256i const bslash = _mm256_set1_epi8('\\');
+      __m256i const tab = _mm256_set1_epi8('\t');
+      __m256i const ws_range = _mm256_set1_epi8('\r' - '\t');
+      for (; i + 32 <= n; i += 32) {
+        __m256i v =
+            _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+        // '\t'..'\r' are contiguous: v - '\t' <= '\r' - '\t' unsigned
+        __m256i rel = _mm256_sub_epi8(v, tab);
+        __m256i ws = _mm256_cmpeq_epi8(_mm256_min_epu8(rel, ws_range), rel);
+        __m256i m = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, space), ws),
+            _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, dquote),
+                                _mm256_cmpeq_epi8(v, squote)),
+                _mm256_cmpeq_epi8(v, bslash)));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(m));
+        if (mask) return i + count_trailing_zeros(mask);
+      }
+#endif
+#if ARGUEME_SIMD_SSE2
+      __m128i const space16 = _mm_set1_epi8(' ');
+      __m128i const dquote16 = _mm_set1_epi8('"');
+      __m128i const squote16 = _mm_set1_epi8('\'');
+      __m128i const bslash16 = _mm_set1_epi8('\\');
+      __m128i const tab16 = _mm_set1_epi8('\t');
+      __m128i const ws_range16 = _mm_set1_epi8('\r' - '\t');
+      for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        __m128i rel = _mm_sub_epi8(v, tab16);
+        __m128i ws = _mm_cmpeq_epi8(_mm_min_epu8(rel, ws_range16), rel);
+        __m128i m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space16), ws),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, dquote16),
+                                      _mm_cmpeq_epi8(v, squote16)),
+                         _mm_cmpeq_epi8(v, bslash16)));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(m));
+        if (mask) return i + count_trailing_zeros(mask);
+      }
+#endif
+      for (; i < n; ++i) {
+        char c = p[i];
+        if (is_space(c) || c == '"' || c == '\'' || c == '\\') return i;
+      }
+      return n;
+    }
+
+    /*
+     * Reads the rest of an argument from position `r`, removing quotes and
+     * escapes, and passes its characters to `put`. Returns a position after
+     * the argument.
+     *
+     * Single quotes keep characters as is; in double quotes a backslash
+     * escapes `"`, `\\`, `$`, `` ` `` and a newline; outside of quotes a
+     * backslash escapes any character. Throws `argument_error` on an
+     * unterminated quote.
+     */
+    template <class Put>
+    std::size_t unquote(char const* data, std::size_t r, std::size_t size,
+                        Put&& put) {
+      while (r < size && !is_space(data[r])) {
+        char c = data[r];
+        if (c == '\'') {
+          ++r;
+          while (r < size && data[r] != '\'') put(data[r++]);
+          if (r == size) throw argument_error(
+                error_message(parse_errc::unterminated_quote));
+          ++r;
+        } else if (c == '"') {
+          ++r;
+          while (r < size && data[r] != '"') {
+            if (data[r] == '\\' && r + 1 < size) {
+              char next = data[r + 1];
+              if (next == '\n') {
+                r += 2;
+                continue;
+              }
+              if (next == '"' || next == '\\' || next == '$' || next == '`')
+                ++r;
+            }
+            put(data[r++]);
+          }
+          if (r == size) throw argument_error(
+                error_message(parse_errc::unterminated_quote));
+          ++r;
+        } else if (c == '\\') {
+          ++r;
+          if (r < size && data[r] == '\n') ++r;
+          else if (r < size) put(data[r++]);
+        } else {
+          put(data[r++]);
+        }
+      }
+      return r;
+    }
+
+    /*
+     * Splits `data` into arguments like a shell does, appending them to
+     * `out`. See `unquote` for quoting rules; `#` at a start of an argument
+     * comments a line out.
+     *
+     * Quotes and escapes are removed in place, so arguments are views of
+     * `data`, and characters are written only after the first removed one.
+     */
+    inline void tokenize_in_place(char* data, std::size_t size,
+                                  std::vector<std::string_view>& out) {
+      std::size_t r = 0;
+      while (r < size) {
+        while (r < size && is_space(data[r])) ++r;
+        if (r == size) break;
+        if (data[r] == '#') {
+          while (r < size && data[r] != '\n') ++r;
+          continue;
+        }
+
+        std::size_t start = r;
+        r += find_special(data + r, size - r);
+        std::size_t w = r;
+        if (r < size && !is_space(data[r]))
+          r = unquote(data, r, size, [&](char c) { data[w++] = c; });
+        out.emplace_back(data + start, w - start);
+      }
+    }
+
+    /*
+     * Splits a command line string into arguments with the same rules, as
+     * `tokenize_in_place`, but without comments, and appends them to `out`.
+     *
+     * Arguments without quotes and escapes are views of `line`, the rest are
+     * unescaped into `storage`, which is cleared first. Its capacity is not
+     * less than a size of the line, so it is not reallocated while arguments
+     * are appended, and views of it stay valid until it is changed.
+     */
+    inline void tokenize(std::string_view line,
+                         std::vector<std::string_view>& out,
+                         std::string& storage) {
+      char const* data = line.data();
+      std::size_t size = line.size();
+      storage.clear();
+
+      std::size_t r = 0;
+      while (r < size) {
+        while (r < size && is_space(data[r])) ++r;
+        if (r == size) break;
+
+        std::size_t start = r;
+        r += find_special(data + r, size - r);
+        if (r == size || is_space(data[r])) {
+          out.emplace_back(data + start, r - start);
+          continue;
+        }
+
+        if (storage.capacity() < size) storage.reserve(size);
+        std::size_t first = storage.size();
+        storage.append(data + start, r - start);
+        r = unquote(data, r, size, [&](char c) { storage.push_back(c); });
+        out.emplace_back(storage.data() + first, storage.size() - first);
+      }
+    }
+
+    /*
+     * Replaces a range of arguments before each parse of a command line, for
+     * example with contents of response files.
+     */
+    class argument_expander {
+    public:
+      /*
+       * If a range has to be replaced, expands it into `arguments()` and
+       * returns true. Otherwise returns false.
+       */
+      virtual bool expand(arg_cursor begin, arg_cursor end) = 0;
+
+      virtual std::vector<std::string_view> const&
+          arguments() const noexcept = 0;
+
+    protected:
+      ~argument_expander() = default;
+    };
+
+  } // namespace details
 
   class command_line {
   public:
@@ -441,9 +2473,15 @@ namespace arg {
 
     /*
      * Attaches a named argument. Intended for internal usage, shall be called
-     * only by arguments.
+     * only by arguments. A type of `arg` is remembered, so the argument is
+     * parsed by a direct call of its `parse`.
      */
-    void attach(details::named_argument& arg) { impl.attach_argument(arg); }
+    template <class Argument>
+    void attach(Argument& arg) {
+      static_assert(std::is_base_of_v<details::named_argument, Argument>,
+                    "Only named arguments are attached without a flag");
+      impl.attach_argument(arg, &details::parse_as<Argument>);
+    }
 
     /*
      * Attaches a positional argument. Intended for internal usage, shall be
@@ -453,33 +2491,192 @@ namespace arg {
       impl.attach_argument(arg, mandatory);
     }
 
+    using cursor_t = details::arg_cursor;
+
     void parse(std::vector<std::string_view> const& vec) {
-      impl.parse(vec.cbegin(), vec.cend());
+      auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+      parse(begin, end);
     }
 
+    /*
+     * Parses arguments of `main`, skipping a program name. Arguments are not
+     * copied.
+     */
     void parse(char** argv, int argc) {
-      std::vector<std::string_view> args;
-      args.reserve(argc - 1);
-      for (int i = 1; i < argc; ++i) args.push_back(argv[i]);
-      impl.parse(args.cbegin(), args.cend());
+      if (argc < 1) return;
+      auto [begin, end] =
+          details::make_cursors<char*>(argv + 1, std::size_t(argc - 1));
+      parse(begin, end);
     }
 
     void parse(const std::vector<std::string>& vec) {
-      std::vector<std::string_view> args;
-      args.reserve(vec.size());
-      for (std::string_view s : vec) args.push_back(s);
-      impl.parse(args.cbegin(), args.cend());
+      auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+      parse(begin, end);
+    }
+
+    /*
+     * Same as `parse`, but returns an error instead of throwing
+     * `argument_error`. A token of an error is a view of a parsed argument,
+     * its index counts arguments after expansion of response files. Errors
+     * of an expansion are still thrown.
+     */
+    parse_status try_parse(std::vector<std::string_view> const& vec) {
+      auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+      return try_parse(begin, end);
+    }
+
+    parse_status try_parse(char** argv, int argc) {
+      if (argc < 1) return {};
+      auto [begin, end] =
+          details::make_cursors<char*>(argv + 1, std::size_t(argc - 1));
+      return try_parse(begin, end);
+    }
+
+    parse_status try_parse(std::vector<std::string> const& vec) {
+      auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+      return try_parse(begin, end);
+    }
+
+    parse_status try_parse(cursor_t begin, cursor_t end) {
+      if (expander && !begin.single_pass() && expander->expand(begin, end)) {
+        auto const& args = expander->arguments();
+        auto [b, e] = details::make_cursors(args.data(), args.size());
+        return impl.try_parse(b, e);
+      }
+      return impl.try_parse(begin, end);
     }
 
     void parse(str_view_vec_t::const_iterator begin,
                str_view_vec_t::const_iterator end) {
-      impl.parse(begin, end);
+      auto [b, e] = details::make_cursors<std::string_view>(
+          begin == end ? nullptr : &*begin, std::size_t(end - begin));
+      parse(b, e);
+    }
+
+    /*
+     * Parses a range of any arguments source, for example a remainder of
+     * other command line, returned by `get_iterator`.
+     *
+     * If response files are enabled, `@path` arguments are replaced with
+     * arguments from the file first.
+     */
+    void parse(cursor_t begin, cursor_t end) {
+      parse_status status = try_parse(begin, end);
+      if (!status) details::throw_parse_error(status.error());
+    }
+
+    /*
+     * Splits a whole command line string into arguments like a shell does
+     * and parses them. See `details::unquote` for quoting rules.
+     *
+     * Arguments are views of `line`, except ones with quotes or escapes,
+     * which are unescaped into an internal buffer. `std::string_view`
+     * values are valid, while `line` is alive and until the next call.
+     */
+    void parse_line(std::string_view line) {
+      line_args.clear();
+      details::tokenize(line, line_args, line_storage);
+      auto [begin, end] =
+          details::make_cursors(line_args.data(), line_args.size());
+      parse(begin, end);
+    }
+
+    /*
+     * Sets an expander of arguments, which is called before each parse,
+     * null disables it. Single pass sources are not expanded. Intended for
+     * internal usage, see `response_files`.
+     */
+    void expand_with(details::argument_expander* e) noexcept {
+      expander = e;
+    }
+
+    /*
+     * Enables the environment layer: arguments, bound with `bind_env`,
+     * take values of environment variables, if they are not given in a
+     * command line. `envp` is a null terminated array of `NAME=value`
+     * strings, it is scanned once per parse. See `use_process_environment`
+     * for the environment of the process.
+     */
+    void use_environment(char** envp) noexcept { impl.use_environment(envp); }
+
+    /*
+     * Same as `use_environment(char**)`, but the environment is returned by
+     * `source` on each parse.
+     */
+    void use_environment(
+        details::command_line_impl::environment_fn source) noexcept {
+      impl.use_environment(source);
+    }
+
+    /*
+     * Sets a config file layer: arguments, bound with `bind_config`, take
+     * values of `key = value` lines, if they are given neither in a command
+     * line, nor in the environment. See `command_line_impl::scan_config`
+     * for a format. Values are views of `text`, which must outlive them.
+     */
+    void use_config(std::string_view text) noexcept {
+      impl.use_config(text);
+    }
+
+    /*
+     * Enables counting of options before each parse, so multi arguments
+     * reserve a storage for all their values at once. It costs one more
+     * name lookup per argument. Single pass sources are not counted.
+     */
+    void reserve_values(bool enable = true) noexcept {
+      impl.reserve_values(enable);
+    }
+
+    /*
+     * Enables lazy conversion of values of value and multi arguments. A
+     * parse only records views of values, they are converted on the first
+     * `get` call, which throws `argument_error`, if a conversion fails.
+     * Views point into parsed strings, so these strings must outlive the
+     * conversion. Call `validate` to convert all values at once. Values,
+     * which are not converted until the next parse, are dropped by it.
+     */
+    void lazy_conversion(bool enable = true) noexcept {
+      impl.lazy_conversion(enable);
+    }
+
+    /*
+     * Converts all values, which conversion has been deferred by a lazy
+     * parse. Returns the first conversion error.
+     */
+    parse_status validate() { return impl.validate(); }
+
+    /*
+     * Returns a monotonic arena of the command line and registers `user`.
+     * Intended for internal usage, shall be called only by arguments.
+     */
+    std::pmr::memory_resource* attach_arena(details::arena_storage& user) {
+      return impl.attach_arena(user);
+    }
+
+    /*
+     * Makes `flush` of `arg` to be called after each parse, even a failed
+     * one. Intended for internal usage, shall be called only by arguments.
+     */
+    void flush_after_parse(details::named_argument& arg) {
+      impl.flush_after_parse(arg);
     }
 
+    /*
+     * Builds a names index. Shall be called after all arguments are
+     * attached, otherwise the first `parse` call does it.
+     */
+    void freeze() { impl.freeze(); }
+
     void stop() noexcept { impl.stop(); }
 
-    std::pair<str_view_vec_t::const_iterator, str_view_vec_t::const_iterator>
-        get_iterator() const noexcept {
+    /*
+     * Waits for tasks of all commands with `async_execution`, which have
+     * been started since the last call. If tasks have thrown, the first
+     * exception is rethrown after all of them have finished.
+     */
+    void wait_commands() { impl.wait_tasks(); }
+
+    std::pair<cursor_t, cursor_t> get_iterator() const noexcept {
       return impl.get_arg_iterator();
     }
 
@@ -489,8 +2686,129 @@ namespace arg {
 
     std::vector<std::string> description() const { return impl.description(); }
 
+    /*
+     * Returns a help text with a line of each named argument. It is rendered
+     * into a single buffer once and cached, until arguments, their
+     * descriptions or `width` change. Descriptions are wrapped by words to
+     * `width` columns, zero width disables wrapping. The view is valid until
+     * the next call.
+     */
+    std::string_view help(std::size_t width = 80) const {
+      return impl.help(width);
+    }
+
+    /*
+     * Writes a help text with a single write.
+     */
+    void write_help(std::ostream& os, std::size_t width = 80) const {
+      auto text = help(width);
+      os.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    /*
+     * Returns false, if the text is not written entirely.
+     */
+    bool write_help(std::FILE* file, std::size_t width = 80) const {
+      auto text = help(width);
+      return std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    }
+
+#if ARGUEME_HAS_POSIX_IO
+    bool write_help(int fd, std::size_t width = 80) const {
+      auto text = help(width);
+      while (!text.empty()) {
+        ssize_t written = ::write(fd, text.data(), text.size());
+        if (written < 0) {
+          if (errno == EINTR) continue;
+          return false;
+        }
+        text.remove_prefix(static_cast<std::size_t>(written));
+      }
+      return true;
+    }
+#endif
+
+    /*
+     * Returns names of arguments, which start with `partial`, sorted. Views
+     * are valid, until arguments change.
+     */
+    std::vector<std::string_view> complete(std::string_view partial) const {
+      std::vector<std::string_view> res;
+      impl.complete(partial, res);
+      return res;
+    }
+
+    /*
+     * Answers a completion query `program __complete <partial>` by writing
+     * matching names, one per line, with a single write. Returns false
+     * without an output, if arguments are not a query. Needs only arguments
+     * to be attached, so it may be called before the rest of a setup.
+     */
+    bool complete(char** argv, int argc, std::ostream& os) const {
+      std::string out;
+      if (!render_completion(argv, argc, out)) return false;
+      os.write(out.data(), static_cast<std::streamsize>(out.size()));
+      return true;
+    }
+
+    bool complete(char** argv, int argc, std::FILE* file = stdout) const {
+      std::string out;
+      if (!render_completion(argv, argc, out)) return false;
+      std::fwrite(out.data(), 1, out.size(), file);
+      return true;
+    }
+
+    /*
+     * Returns a completion script for `shell`, which completes names of
+     * arguments of `program` with their descriptions.
+     */
+    std::string completion_script(completion_shell shell,
+                                  std::string_view program) const {
+      return impl.completion_script(shell, program);
+    }
+
+#if ARGUEME_INSTRUMENT
+    /*
+     * Counters and timings of all parses since the command line is created
+     * or `reset_stats` is called. It is a copy, so it may be taken while
+     * deferred commands run on other threads.
+     */
+    parse_stats stats() const { return impl.stats(); }
+
+    void reset_stats() { impl.reset_stats(); }
+
+    /*
+     * Sets a callback, which receives every measurement. It is called
+     * synchronously under a lock of statistics, so it shall be cheap and it
+     * must not call `stats`. Calls are never concurrent.
+     */
+    void observe(parse_observer observer) {
+      impl.observe(std::move(observer));
+    }
+
+    /*
+     * Measures an execution of a deferred command. Intended for internal
+     * usage, shall be called only by commands.
+     */
+    template <class F>
+    void measure_command(std::string_view name, F&& f) {
+      impl.measure(parse_phase::command, {}, name, std::forward<F>(f));
+    }
+#endif
+
   private:
+    bool render_completion(char** argv, int argc, std::string& out) const {
+      if (argc < 2 || std::string_view(argv[1]) != "__complete") return false;
+      std::vector<std::string_view> names;
+      impl.complete(argc > 2 ? argv[2] : "", names);
+      for (auto name : names) out.append(name).append("\n");
+      return true;
+    }
+
     details::command_line_impl impl;
+    details::argument_expander* expander = nullptr;
+    std::vector<std::string_view> line_args;
+    std::string line_storage;
     std::string_view longname_p;
     std::string_view shortname_p;
   };
@@ -508,43 +2826,347 @@ namespace arg {
       cmdline.attach(*this);
     }
 
-    virtual void parse(details::command_line_impl& cmdline) override final {
-      if (activited) throw argument_error("Option can be appeared only once");
+    virtual parse_errc
+        parse(details::command_line_impl& cmdline) override final {
+      if (activited) return parse_errc::repeated_option;
       activited = true;
-      auto s = cmdline.next_argument();
-      if (!s || cmdline.is_argument(*s))
-        throw argument_error("Option requires a value");
-      this->value = util::from_string<T>(*s);
+      auto s = cmdline.next_value();
+      if (!s) return parse_errc::value_required;
+      if (cmdline.is_lazy()) {
+        pending = cmdline.defer(*s);
+        return parse_errc::ok;
+      }
+      if (!cmdline.convert(*s, this->value))
+        return parse_errc::invalid_value;
+      return parse_errc::ok;
+    }
+
+    virtual bool takes_value() const noexcept override { return true; }
+
+    /*
+     * Drops a lazily parsed value of the previous parse, which has not been
+     * converted: it may refer to arguments, which do not exist anymore.
+     */
+    virtual void begin_parse() noexcept override {
+      activited = false;
+      pending.reset();
+    }
+
+    virtual parse_status validate() override {
+      if (pending) {
+        if (!util::try_from_string(pending->value, this->value))
+          return *pending;
+        pending.reset();
+      }
+      return {};
+    }
+
+    /*
+     * Returns a value. A lazily parsed value is converted on the first
+     * call, `argument_error` is thrown, if it cannot be converted.
+     */
+    T const& get() const {
+      if (pending) {
+        if (!util::try_from_string(pending->value, this->value))
+          details::throw_parse_error(*pending);
+        pending.reset();
+      }
+      return this->value;
     }
 
     virtual ~value_argument() override {}
   private:
     bool activited = false;
+    mutable std::optional<parse_error> pending;
   };
 
-  template <typename T>
-  class multi_argument : public details::named_argument {
+  /*
+   * Argument, which may appear many times, each value is appended to a
+   * vector.
+   *
+   * With `std::pmr::polymorphic_allocator` (see `pmr_multi_argument`) the
+   * vector and strings in it are allocated in a monotonic arena of the
+   * command line. The arena is released in one shot at the start of each
+   * parse, so values of a previous parse are dropped.
+   */
+  template <typename T, class Allocator = std::allocator<T>>
+  class multi_argument : public details::named_argument,
+                         details::arena_storage {
+    static constexpr bool in_arena =
+        std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>>;
+
   public:
     multi_argument(std::string_view longname, std::string_view shortname,
                    command_line& cmdline,
                    prefix_policy prefix = prefix_policy::optional)
-        : details::named_argument(longname, shortname, prefix) {
+        : details::named_argument(longname, shortname, prefix),
+          value(make_vector(cmdline)) {
       cmdline.attach(*this);
     }
 
-    virtual void parse(details::command_line_impl& cmdline) override final {
-      auto s = cmdline.next_argument();
-      if (!s || cmdline.is_argument(*s))
-        throw argument_error("Option requires a value");
-      T value = util::from_string<T>(*s);
-      this->value.push_back(value);
+    virtual parse_errc
+        parse(details::command_line_impl& cmdline) override final {
+      auto s = cmdline.next_value();
+      if (!s) return parse_errc::value_required;
+      if (callback || forwarding) {
+        T value {};
+        if (!cmdline.convert(*s, value)) return parse_errc::invalid_value;
+        receive(std::move(value));
+        return parse_errc::ok;
+      }
+      if (cmdline.is_lazy()) {
+        pending.push_back(cmdline.defer(*s));
+        return parse_errc::ok;
+      }
+      if (!append(*s, [&](std::string_view s, T& res) {
+            return cmdline.convert(s, res);
+          }))
+        return parse_errc::invalid_value;
+      return parse_errc::ok;
+    }
+
+    virtual bool takes_value() const noexcept override { return true; }
+
+    // views of the previous parse may refer to freed arguments
+    virtual void begin_parse() noexcept override { pending.clear(); }
+
+    virtual void reserve(std::size_t count) override {
+      // values passed to a callback are not kept
+      if (!callback && !forwarding) value.reserve(value.size() + count);
     }
 
+    virtual parse_status validate() override { return convert_pending(); }
+
+    /*
+     * Sets a callback, which receives each value, as soon as it is parsed,
+     * instead of appending it to the vector. Null callback restores
+     * appending.
+     */
+    void on_value(std::function<void(T&&)> f) { callback = std::move(f); }
+
     virtual ~multi_argument() override {};
 
-    std::vector<T> const& get() const noexcept { return value; }
+    using vector_t = std::vector<T, Allocator>;
+
+    /*
+     * Returns values. Lazily parsed values are converted on the first
+     * call, `argument_error` is thrown, if one of them cannot be converted.
+     */
+    vector_t const& get() const {
+      auto status = convert_pending();
+      if (!status) details::throw_parse_error(status.error());
+      return value;
+    }
+
+  protected:
+    /*
+     * Receives each value instead of the vector, if `forwarding` is set by
+     * a derived argument or a callback is set. By default calls the
+     * callback.
+     */
+    virtual void receive(T&& value) { callback(std::move(value)); }
+
+    bool forwarding = false;
+
+  private:
+    parse_status convert_pending() const {
+      std::size_t i = 0;
+      for (; i < pending.size(); ++i) {
+        if (!append(pending[i].value, util::try_from_string<T>)) break;
+      }
+      pending.erase(pending.begin(), pending.begin() + i);
+      if (!pending.empty()) return pending.front();
+      return {};
+    }
+
+    template <typename Convert>
+    bool append(std::string_view s, Convert convert) const {
+      if constexpr (std::uses_allocator_v<T, Allocator>) {
+        // a string is constructed in place with an allocator of the vector
+        value.emplace_back();
+        if (!convert(s, value.back())) {
+          value.pop_back();
+          return false;
+        }
+      } else {
+        T res {};
+        if (!convert(s, res)) return false;
+        value.push_back(std::move(res));
+      }
+      return true;
+    }
+
+    // a polymorphic allocator is not propagated on an assignment, so the
+    // vector is constructed with it
+    vector_t make_vector(command_line& cmdline) {
+      if constexpr (in_arena)
+        return vector_t(Allocator(cmdline.attach_arena(*this)));
+      else return vector_t();
+    }
+
+    virtual void drop_values() noexcept override {
+      if constexpr (in_arena) {
+        vector_t empty(value.get_allocator());
+        value.swap(empty);
+        pending.clear();
+      }
+    }
+
+    // mutable, because lazily parsed values are converted on access
+    mutable vector_t value;
+    mutable std::vector<parse_error> pending;
+    std::function<void(T&&)> callback;
+  };
+
+  template <typename T>
+  using pmr_multi_argument =
+      multi_argument<T, std::pmr::polymorphic_allocator<T>>;
+
+  /*
+   * Argument, which value is a list of elements separated by `Delim`, like
+   * `--ids=1,2,3`. It may appear many times, elements of all values are
+   * appended to one vector. An empty value has no elements, otherwise each
+   * piece, even an empty one, must be a valid element.
+   *
+   * `std::string_view` elements refer to characters of the argument, they
+   * are not copied, so they are valid as long as arguments are.
+   */
+  template <typename T, char Delim = ','>
+  class list_argument : public details::named_argument {
+  public:
+    list_argument(std::string_view longname, std::string_view shortname,
+                  command_line& cmdline,
+                  prefix_policy prefix = prefix_policy::optional)
+        : details::named_argument(longname, shortname, prefix) {
+      cmdline.attach(*this);
+    }
+
+    virtual parse_errc
+        parse(details::command_line_impl& cmdline) override final {
+      auto s = cmdline.next_value();
+      if (!s) return parse_errc::value_required;
+      if (cmdline.is_lazy()) {
+        pending.push_back(cmdline.defer(*s));
+        return parse_errc::ok;
+      }
+      if (!append(*s, [&](std::string_view s, T& res) {
+            return cmdline.convert(s, res);
+          }))
+        return parse_errc::invalid_value;
+      return parse_errc::ok;
+    }
+
+    virtual bool takes_value() const noexcept override { return true; }
+
+    // views of the previous parse may refer to freed arguments
+    virtual void begin_parse() noexcept override { pending.clear(); }
+
+    virtual parse_status validate() override { return convert_pending(); }
+
+    /*
+     * Returns elements. Lazily parsed values are split on the first call,
+     * `argument_error` is thrown, if an element cannot be converted.
+     */
+    std::vector<T> const& get() const {
+      auto status = convert_pending();
+      if (!status) details::throw_parse_error(status.error());
+      return value;
+    }
+
+    virtual ~list_argument() override {}
+  private:
+    parse_status convert_pending() const {
+      std::size_t i = 0;
+      for (; i < pending.size(); ++i) {
+        if (!append(pending[i].value, util::try_from_string<T>)) break;
+      }
+      pending.erase(pending.begin(), pending.begin() + i);
+      if (!pending.empty()) return pending.front();
+      return {};
+    }
+
+    /*
+     * Splits `s` and appends its elements. The vector is reserved for all
+     * of them at once, elements of an invalid value are removed.
+     */
+    template <typename Convert>
+    bool append(std::string_view s, Convert convert) const {
+      if (s.empty()) return true;
+      std::size_t size = value.size();
+      std::size_t need =
+          size + details::count_char(s.data(), s.size(), Delim) + 1;
+      if (need > value.capacity())
+        value.reserve(std::max(need, 2 * value.capacity()));
+      bool ok = details::split(s, Delim, [&](std::string_view piece) {
+        value.emplace_back();
+        return convert(piece, value.back());
+      });
+      if (!ok) value.resize(size);
+      return ok;
+    }
+
+    // mutable, because lazily parsed values are converted on access
+    mutable std::vector<T> value;
+    mutable std::vector<parse_error> pending;
+  };
+
+  /*
+   * Argument, which may appear many times like `multi_argument`, but hands
+   * values over to a sink in batches instead of keeping them, so a program
+   * may start work during parsing. To receive each value separately, use
+   * `multi_argument::on_value`.
+   *
+   * A sink receives `batch_size` values at once, a rest is handed over at
+   * the end of a parse. Values may be moved out of a batch, it is cleared
+   * after the call.
+   */
+  template <typename T>
+  class sink_argument : public multi_argument<T> {
+  public:
+    using batch_sink = std::function<void(std::vector<T>&)>;
+
+    sink_argument(std::string_view longname, std::string_view shortname,
+                  command_line& cmdline, batch_sink sink,
+                  std::size_t batch_size,
+                  prefix_policy prefix = prefix_policy::optional)
+        : multi_argument<T>(longname, shortname, cmdline, prefix),
+          to_batch(std::move(sink)), size(batch_size > 0 ? batch_size : 1) {
+      batch.reserve(size);
+      this->forwarding = true;
+      cmdline.flush_after_parse(*this);
+    }
+
+    /*
+     * Hands over a partial batch.
+     */
+    virtual void flush() override {
+      if (batch.empty()) return;
+      to_batch(batch);
+      batch.clear();
+    }
+
+    /*
+     * Returns a number of values, which have been parsed.
+     */
+    std::size_t count() const noexcept { return total; }
+
+    virtual ~sink_argument() override {}
+
+  protected:
+    virtual void receive(T&& value) override {
+      ++total;
+      batch.push_back(std::move(value));
+      if (batch.size() == size) flush();
+    }
+
   private:
-    std::vector<T> value;
+    // values go to the sink only
+    using multi_argument<T>::on_value;
+
+    batch_sink to_batch;
+    std::size_t size;
+    std::vector<T> batch;
+    std::size_t total = 0;
   };
 
   template <typename T>
@@ -557,10 +3179,13 @@ namespace arg {
       cmdline.attach(*this, is_mandatory);
     }
 
-    virtual void parse(details::command_line_impl& cmdline) override final {
+    virtual parse_errc
+        parse(details::command_line_impl& cmdline) override final {
       auto s = cmdline.get_argument();
-      if (!s) throw argument_error("Option requires a value");
-      this->value = util::from_string<T>(*s);
+      if (!s) return parse_errc::value_required;
+      if (!cmdline.convert(*s, this->value))
+        return parse_errc::invalid_value;
+      return parse_errc::ok;
     }
 
     virtual ~positional_argument() override {}
@@ -575,15 +3200,28 @@ namespace arg {
                     bool default_value = false)
         : details::named_argument(longname, shortname, prefix),
           details::argument_template<bool>(default_value) {
-      value = default_value;
+      set(default_value);
       cmdline.attach(*this);
     }
 
-    virtual void parse(details::command_line_impl&) override final {
+    virtual parse_errc parse(details::command_line_impl&) override final {
       value = !value;
+      return parse_errc::ok;
+    }
+
+    /*
+     * Sets a value of the environment or a config file, a switch is not
+     * toggled by it.
+     */
+    virtual parse_errc parse_flag(details::command_line_impl&,
+                                  bool on) override {
+      set(on);
+      return parse_errc::ok;
     }
 
     virtual ~switch_argument() override {}
+  private:
+    void set(bool on) noexcept { value = on; }
   };
 
   class deferred_execution {
@@ -615,14 +3253,35 @@ namespace arg {
             prefix_policy prefix = prefix_policy::optional)
         : details::named_argument(longname, shortname, prefix), f(functor) {
       cmdline.attach(*this);
+#if ARGUEME_INSTRUMENT
+      owner = &cmdline;
+#endif
     }
 
-    virtual void parse(details::command_line_impl&) override final {
-      this->execute_now(f);
+    virtual parse_errc
+        parse(details::command_line_impl& cmdline) override final {
+      if constexpr (std::is_base_of_v<deferred_execution, ExecutionPolicy>)
+        this->execute_now(f);
+      else if constexpr (!std::is_void_v<decltype(this->execute_now(f))>)
+        // the policy has started a task and returned a function, which
+        // waits for it, see `async_execution`
+        cmdline.measure(parse_phase::command, {}, lname, [&] {
+          cmdline.start_task(this->execute_now(f));
+        });
+      else
+        cmdline.measure(parse_phase::command, {}, lname,
+                        [this] { this->execute_now(f); });
       active = true;
+      return parse_errc::ok;
     }
 
-    void execute() { this->execute_deffered(f); }
+    void execute() {
+#if ARGUEME_INSTRUMENT
+      owner->measure_command(lname, [this] { this->execute_deffered(f); });
+#else
+      this->execute_deffered(f);
+#endif
+    }
 
     bool activited() const noexcept { return active; }
 
@@ -630,6 +3289,108 @@ namespace arg {
   private:
     Functor f;
     bool active = false;
+#if ARGUEME_INSTRUMENT
+    command_line* owner;
+#endif
+  };
+
+  /*
+   * Parser of a subcommand. A derived class attaches its arguments to
+   * `cmdline`, it is created by `subcommands` only when its name is matched.
+   */
+  class subcommand {
+  public:
+    subcommand(std::string_view longname_prefix,
+               std::string_view shortname_prefix)
+        : cmdline(longname_prefix, shortname_prefix) {}
+
+    subcommand(subcommand const&) = delete;
+    subcommand& operator=(subcommand const&) = delete;
+
+    command_line& parser() noexcept { return cmdline; }
+
+    virtual ~subcommand() {}
+  protected:
+    command_line cmdline;
+  };
+
+  /*
+   * Positional argument, which selects a subcommand by its name.
+   *
+   * Each subcommand is registered with a factory of its parser. When a name
+   * is matched, only that parser is created, parsing of the parent command
+   * line stops and the remaining arguments are parsed by the subcommand
+   * without copying. An error of the subcommand is reported by the parent
+   * with an index counted from the start of the parent arguments.
+   */
+  class subcommands : public details::argument {
+  public:
+    using factory_t = std::function<std::unique_ptr<subcommand>()>;
+
+    subcommands(command_line& cmdline, bool is_mandatory = false) {
+      cmdline.attach(*this, is_mandatory);
+    }
+
+    void add(std::string_view name, factory_t factory) {
+      entries.push_back(entry { name, std::move(factory) });
+      frozen = false;
+    }
+
+    template <class Parser>
+    void add(std::string_view name) {
+      add(name, [] { return std::make_unique<Parser>(); });
+    }
+
+    virtual parse_errc
+        parse(details::command_line_impl& cmdline) override final {
+      auto s = cmdline.get_argument();
+      if (!s) return parse_errc::value_required;
+      if (!frozen) freeze();
+      std::size_t id = names.find(*s);
+      if (id == details::name_index::npos)
+        return parse_errc::unrecognized_argument;
+
+      active = entries[id].factory();
+      active_name = entries[id].name;
+      auto [begin, end] = cmdline.get_arg_iterator();
+      cmdline.stop();
+      parse_status status = active->parser().try_parse(++begin, end);
+      if (!status) return cmdline.nested_error(status.error());
+      return parse_errc::ok;
+    }
+
+    /*
+     * Returns a parser of the matched subcommand or null, if no subcommand
+     * has been matched.
+     */
+    subcommand* get() const noexcept { return active.get(); }
+
+    template <class Parser>
+    Parser* get_as() const noexcept {
+      return dynamic_cast<Parser*>(active.get());
+    }
+
+    std::string_view name() const noexcept { return active_name; }
+
+    virtual ~subcommands() override {}
+  private:
+    struct entry {
+      std::string_view name;
+      factory_t factory;
+    };
+
+    void freeze() {
+      names.reset(entries.size());
+      for (std::size_t i = 0; i < entries.size(); ++i)
+        names.insert(entries[i].name, i);
+      frozen = true;
+    }
+
+    std::vector<entry> entries;
+    details::name_index names;
+    bool frozen = false;
+    std::unique_ptr<subcommand> active;
+    std::string_view active_name;
   };
 
 } // namespace arg
@@ -0,0 +1,47 @@
+#ifndef ARGUEME_ASYNC_HPP
+#define ARGUEME_ASYNC_HPP
+
+#include <argueme/arg.hpp>
+#include <functional>
+#include <future>
+#include <type_traits>
+
+namespace arg {
+
+  namespace details {
+
+    template <typename T>
+    struct is_future : std::false_type {};
+
+    template <typename T>
+    struct is_future<std::future<T>> : std::true_type {};
+
+    template <typename T>
+    constexpr bool is_future_v = is_future<T>::value;
+
+  } // namespace details
+
+  /*
+   * Starts a command during parsing without waiting for it. A functor,
+   * which returns `std::future`, starts a task itself, otherwise it is run
+   * with `std::async`. Tasks are awaited by `command_line::wait_commands`.
+   */
+  class async_execution {
+  protected:
+    template <class Functor>
+    std::function<void()> execute_now(Functor functor) {
+      if constexpr (details::is_future_v<std::invoke_result_t<Functor>>)
+        return wait_for(std::invoke(functor));
+      else return wait_for(std::async(std::launch::async, functor));
+    }
+
+  private:
+    template <typename R>
+    static std::function<void()> wait_for(std::future<R> task) {
+      return [task = task.share()] { task.get(); };
+    }
+  };
+
+} // namespace arg
+
+#endif
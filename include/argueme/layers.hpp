@@ -0,0 +1,87 @@
+#ifndef ARGUEME_LAYERS_HPP
+#define ARGUEME_LAYERS_HPP
+
+#include <argueme/arg.hpp>
+#include <argueme/mapped_file.hpp>
+#include <string>
+
+/*
+ * Access to the environment of the process. macOS does not export
+ * `environ` to shared libraries, it is taken with `_NSGetEnviron` there.
+ */
+#ifndef ARGUEME_HAS_ENVIRON
+  #if defined(__APPLE__) || defined(__unix__) || defined(_WIN32)
+    #define ARGUEME_HAS_ENVIRON 1
+  #else
+    #define ARGUEME_HAS_ENVIRON 0
+  #endif
+#endif
+
+#if ARGUEME_HAS_ENVIRON
+  #if defined(__APPLE__)
+    #include <crt_externs.h>
+  #elif defined(_WIN32)
+    #include <stdlib.h>
+  #else
+extern "C" {
+  extern char** environ;
+}
+  #endif
+#endif
+
+namespace arg {
+
+  namespace details {
+
+    /*
+     * Returns the environment of the process or null, if it is not
+     * available.
+     */
+    inline char** process_environment() noexcept {
+#if !ARGUEME_HAS_ENVIRON
+      return nullptr;
+#elif defined(__APPLE__)
+      return *_NSGetEnviron();
+#elif defined(_WIN32)
+      return _environ;
+#else
+      return ::environ;
+#endif
+    }
+
+  } // namespace details
+
+  /*
+   * Enables the environment layer of `cmdline` with the environment of the
+   * process. It is taken on each parse, so variables, set after this call,
+   * are seen.
+   */
+  inline void use_process_environment(command_line& cmdline) noexcept {
+    cmdline.use_environment(&details::process_environment);
+  }
+
+  /*
+   * Config file, which is mapped and set as a config file layer of a
+   * command line. The file is kept, while the object is alive, values of
+   * `std::string_view` arguments point into it.
+   */
+  class config_file {
+  public:
+    /*
+     * Throws `argument_error`, if the file can not be opened.
+     */
+    config_file(command_line& cmdline, std::string const& path)
+        : cmdline(cmdline), file(path, "Cannot open a config file") {
+      cmdline.use_config({ file.data(), file.size() });
+    }
+
+    ~config_file() { cmdline.use_config({}); }
+
+  private:
+    command_line& cmdline;
+    details::mapped_file file;
+  };
+
+} // namespace arg
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef ARGUEME_MAPPED_FILE_HPP
+#define ARGUEME_MAPPED_FILE_HPP
+
+#include <argueme/arg.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/*
+ * Memory mapping of files, which response files and config files use.
+ */
+#ifndef ARGUEME_HAS_MMAP
+  #if defined(__unix__) || defined(__APPLE__)
+    #define ARGUEME_HAS_MMAP 1
+  #else
+    #define ARGUEME_HAS_MMAP 0
+  #endif
+#endif
+
+#if ARGUEME_HAS_MMAP
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+#endif
+
+namespace arg {
+
+  namespace details {
+
+    /*
+     * File, mapped into memory for reading. The mapping is private, so the
+     * contents may be changed in place without changing the file: changed
+     * pages are copied on write. Where memory mapping is not available,
+     * the file is read into a buffer.
+     */
+    class mapped_file {
+    public:
+      /*
+       * Maps a file. Throws `argument_error` with `error`, if the file can
+       * not be opened.
+       */
+      explicit mapped_file(
+          std::string const& path,
+          char const* error = "Cannot open a response file") {
+#if ARGUEME_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw argument_error(error);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+          ::close(fd);
+          throw argument_error(error);
+        }
+        len = static_cast<std::size_t>(st.st_size);
+        if (len > 0) {
+          void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                           fd, 0);
+          if (p == MAP_FAILED) {
+            ::close(fd);
+            throw argument_error(error);
+          }
+          ptr = static_cast<char*>(p);
+        }
+        ::close(fd);
+#else
+        std::ifstream is(path, std::ios::binary | std::ios::ate);
+        if (!is) throw argument_error(error);
+        len = static_cast<std::size_t>(is.tellg());
+        buffer.reset(new char[len + 1]);
+        is.seekg(0);
+        is.read(buffer.get(), len);
+        ptr = buffer.get();
+#endif
+      }
+
+      mapped_file(mapped_file const&) = delete;
+      mapped_file& operator=(mapped_file const&) = delete;
+
+      ~mapped_file() {
+#if ARGUEME_HAS_MMAP
+        if (ptr) ::munmap(ptr, len);
+#endif
+      }
+
+      char* data() noexcept { return ptr; }
+
+      std::size_t size() const noexcept { return len; }
+
+    private:
+      char* ptr = nullptr;
+      std::size_t len = 0;
+#if !ARGUEME_HAS_MMAP
+      std::unique_ptr<char[]> buffer;
+#endif
+    };
+
+  } // namespace details
+
+} // namespace arg
+
+#endif
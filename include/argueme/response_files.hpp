@@ -0,0 +1,114 @@
+#ifndef ARGUEME_RESPONSE_FILES_HPP
+#define ARGUEME_RESPONSE_FILES_HPP
+
+#include <argueme/arg.hpp>
+#include <argueme/mapped_file.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace arg {
+
+  /*
+   * Expands `@path` arguments of each parse of a command line with contents
+   * of response files.
+   *
+   * Files are mapped and tokenized in place, so expanded arguments are
+   * views of mappings. Mappings of a parse are kept until the next parse or
+   * until `release` is called, and values of arguments, which refer to
+   * them, are valid until then.
+   * Response files may contain other `@path` arguments, a file, which
+   * includes itself, is an error. Single pass sources are not expanded.
+   */
+  class response_files : public details::argument_expander {
+  public:
+    explicit response_files(command_line& cmdline) : cmdline(cmdline) {
+      cmdline.expand_with(this);
+    }
+
+    response_files(response_files const&) = delete;
+    response_files& operator=(response_files const&) = delete;
+
+    ~response_files() { cmdline.expand_with(nullptr); }
+
+    /*
+     * Unmaps files of the previous parse. If there are `@path` arguments in
+     * a range, expands the range into `arguments()` and returns true.
+     * Otherwise returns false.
+     */
+    virtual bool expand(details::arg_cursor begin,
+                        details::arg_cursor end) override {
+      release();
+      bool found = false;
+      for (auto it = begin; it != end && !found; ++it)
+        found = is_response_file(*it);
+      if (!found) return false;
+
+      std::vector<std::string> stack;
+      for (auto it = begin; it != end; ++it) add(*it, stack);
+      return true;
+    }
+
+    virtual std::vector<std::string_view> const&
+        arguments() const noexcept override {
+      return args;
+    }
+
+    /*
+     * Unmaps all files. Arguments, which refer to them, become invalid.
+     */
+    void release() noexcept {
+      args.clear();
+      files.clear();
+    }
+
+    /*
+     * Returns a number of files, which are mapped.
+     */
+    std::size_t size() const noexcept { return files.size(); }
+
+  private:
+    static bool is_response_file(std::string_view s) noexcept {
+      return s.size() > 1 && s.front() == '@';
+    }
+
+    void add(std::string_view s, std::vector<std::string>& stack) {
+      if (!is_response_file(s)) {
+        args.push_back(s);
+        return;
+      }
+
+      std::error_code ec;
+      auto path = std::filesystem::canonical(
+          std::filesystem::path(s.substr(1)), ec);
+      if (ec) throw argument_error("Cannot open a response file", s);
+      std::string name = path.string();
+      for (auto const& p : stack)
+        if (p == name) throw argument_error("Recursive response file", s);
+
+      std::vector<std::string_view> tokens;
+      try {
+        files.push_back(std::make_unique<details::mapped_file>(name));
+        details::tokenize_in_place(files.back()->data(),
+                                   files.back()->size(), tokens);
+      } catch (argument_error const& e) {
+        throw argument_error(e.what(), s);
+      }
+
+      stack.push_back(std::move(name));
+      for (auto t : tokens) add(t, stack);
+      stack.pop_back();
+    }
+
+    command_line& cmdline;
+    std::vector<std::unique_ptr<details::mapped_file>> files;
+    std::vector<std::string_view> args;
+  };
+
+} // namespace arg
+
+#endif
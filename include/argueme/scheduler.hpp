@@ -0,0 +1,253 @@
+#ifndef ARGUEME_SCHEDULER_HPP
+#define ARGUEME_SCHEDULER_HPP
+
+#include <argueme/arg.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace arg {
+
+  enum class task_state {
+    inactive, // command has not been activated by a parse
+    done,
+    failed,   // command has thrown an exception
+    skipped   // command has not been executed, because a preceding failed
+  };
+
+  struct task_result {
+    std::string_view name;
+    task_state state = task_state::inactive;
+    std::exception_ptr error;
+  };
+
+  /*
+   * Thrown by `scheduler::execute`, holds results of all failed commands.
+   */
+  class execution_error : public std::exception {
+  public:
+    explicit execution_error(std::vector<task_result> failures)
+        : what_str(std::to_string(failures.size()) + " command(s) failed"),
+          failed(std::move(failures)) {}
+
+    virtual char const* what() const noexcept override {
+      return what_str.c_str();
+    }
+
+    std::vector<task_result> const& failures() const noexcept {
+      return failed;
+    }
+  private:
+    std::string what_str;
+    std::vector<task_result> failed;
+  };
+
+  /*
+   * Executes activated deferred commands on a pool of threads.
+   *
+   * Commands are independent, unless an order is declared with `after`. A
+   * constraint with an inactive command still orders commands around it, a
+   * command is skipped, if any command it runs after has failed or has been
+   * skipped. Without constraints and with a single thread, commands are
+   * executed in the order they were added, same as `util::execute`.
+   */
+  class scheduler {
+  public:
+    using task_id = std::size_t;
+
+    /*
+     * Takes a number of threads, zero means a number of hardware threads.
+     */
+    explicit scheduler(std::size_t threads = 0) : threads_count(threads) {
+      if (threads_count == 0)
+        threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    template <class Functor, class ExecutionPolicy>
+    task_id add(command<Functor, ExecutionPolicy>& cmd) {
+      static_assert(std::is_base_of_v<deferred_execution, ExecutionPolicy>,
+                    "Only deferred commands can be scheduled");
+      tasks.push_back(task { cmd.longname(),
+                             [&cmd] { return cmd.activited(); },
+                             [&cmd] { cmd.execute(); },
+                             {},
+                             0 });
+      return tasks.size() - 1;
+    }
+
+    /*
+     * Declares, that a command `later` is executed after `earlier` has
+     * finished.
+     */
+    void after(task_id later, task_id earlier) {
+      if (later >= tasks.size() || earlier >= tasks.size())
+        throw command_line_error("Unknown command in an ordering constraint");
+      tasks[earlier].successors.push_back(later);
+      ++tasks[later].predecessors;
+    }
+
+    /*
+     * Executes activated commands and waits for them. Returns results in
+     * the order commands were added. Exceptions of commands are not thrown,
+     * they are stored in results. Throws `command_line_error`, if ordering
+     * constraints have a cycle.
+     */
+    std::vector<task_result> run() {
+      check_cycles();
+
+      execution ex(tasks);
+      {
+        std::lock_guard<std::mutex> lock(ex.m);
+        for (task_id id = 0; id < tasks.size(); ++id)
+          if (tasks[id].predecessors == 0) ex.release(id);
+      }
+
+      std::size_t helpers = std::min(threads_count, tasks.size());
+      std::vector<std::thread> workers;
+      for (std::size_t t = 1; t < helpers; ++t)
+        workers.emplace_back([&ex] { ex.work(); });
+      ex.work();
+      for (auto& w : workers) w.join();
+      return std::move(ex.results);
+    }
+
+    /*
+     * Same as `run`, but throws `execution_error`, if any command has
+     * failed.
+     */
+    std::vector<task_result> execute() {
+      auto results = run();
+      std::vector<task_result> failures;
+      for (auto const& r : results)
+        if (r.state == task_state::failed) failures.push_back(r);
+      if (!failures.empty()) throw execution_error(std::move(failures));
+      return results;
+    }
+  private:
+    struct task {
+      std::string_view name;
+      std::function<bool()> activated;
+      std::function<void()> run;
+      std::vector<task_id> successors;
+      std::size_t predecessors;
+    };
+
+    /*
+     * State of a single `run`. All members, except a state of a running
+     * command, are guarded by `m`.
+     */
+    struct execution {
+      explicit execution(std::vector<task>& t)
+          : tasks(t), results(t.size()), waiting(t.size()),
+            blocked(t.size(), false), remaining(t.size()) {
+        for (task_id id = 0; id < tasks.size(); ++id) {
+          results[id].name = tasks[id].name;
+          waiting[id] = tasks[id].predecessors;
+        }
+      }
+
+      /*
+       * Called, when all predecessors of `id` have finished. Queues an
+       * activated command, other commands are finished in place, so their
+       * successors are released too.
+       */
+      void release(task_id id) {
+        std::vector<task_id> stack { id };
+        while (!stack.empty()) {
+          task_id t = stack.back();
+          stack.pop_back();
+          if (tasks[t].activated()) {
+            if (!blocked[t]) {
+              ready.push_back(t);
+              continue;
+            }
+            results[t].state = task_state::skipped;
+          }
+          finish(t, stack);
+        }
+      }
+
+      void finish(task_id id, std::vector<task_id>& released) {
+        --remaining;
+        bool failed = blocked[id] || results[id].state == task_state::failed;
+        for (task_id s : tasks[id].successors) {
+          if (failed) blocked[s] = true;
+          if (--waiting[s] == 0) released.push_back(s);
+        }
+      }
+
+      void work() {
+        std::unique_lock<std::mutex> lock(m);
+        while (true) {
+          cv.wait(lock, [this] { return !ready.empty() || remaining == 0; });
+          if (ready.empty()) return;
+          task_id id = ready.front();
+          ready.pop_front();
+          lock.unlock();
+          try {
+            tasks[id].run();
+            results[id].state = task_state::done;
+          } catch (...) {
+            results[id].state = task_state::failed;
+            results[id].error = std::current_exception();
+          }
+          lock.lock();
+
+          std::vector<task_id> released;
+          finish(id, released);
+          for (task_id s : released) release(s);
+          cv.notify_all();
+        }
+      }
+
+      std::vector<task>& tasks;
+      std::vector<task_result> results;
+      std::vector<std::size_t> waiting;
+      std::vector<bool> blocked;
+      std::size_t remaining;
+      std::deque<task_id> ready;
+      std::mutex m;
+      std::condition_variable cv;
+    };
+
+    /*
+     * Checks, that ordering constraints have no cycle, by Kahn's algorithm.
+     */
+    void check_cycles() const {
+      std::vector<std::size_t> waiting(tasks.size());
+      std::vector<task_id> stack;
+      for (task_id id = 0; id < tasks.size(); ++id) {
+        waiting[id] = tasks[id].predecessors;
+        if (waiting[id] == 0) stack.push_back(id);
+      }
+      std::size_t visited = 0;
+      while (!stack.empty()) {
+        task_id id = stack.back();
+        stack.pop_back();
+        ++visited;
+        for (task_id s : tasks[id].successors)
+          if (--waiting[s] == 0) stack.push_back(s);
+      }
+      if (visited == tasks.size()) return;
+      for (task_id id = 0; id < tasks.size(); ++id)
+        if (waiting[id] != 0)
+          throw command_line_error("Ordering of commands has a cycle",
+                                   tasks[id].name);
+    }
+
+    std::vector<task> tasks;
+    std::size_t threads_count;
+  };
+
+} // namespace arg
+
+#endif
@@ -0,0 +1,680 @@
+#ifndef ARGUEME_SCHEMA_HPP
+#define ARGUEME_SCHEMA_HPP
+
+#include <argueme/arg.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace arg {
+
+  class schema;
+  class parse_result;
+
+  /*
+   * Typed handle of an option, returned by `schema`. `T` is a type of the
+   * option value in a `parse_result`.
+   */
+  template <typename T>
+  class option_key {
+  public:
+    std::size_t id() const noexcept { return index; }
+
+  private:
+    friend class schema;
+
+    explicit option_key(std::size_t id) noexcept : index(id) {}
+
+    std::size_t index;
+  };
+
+  namespace details {
+
+    enum class option_kind { value, multi, switch_, positional };
+
+    /*
+     * Type erased column of option values of a batch, one value per line.
+     */
+    class column_base {
+    public:
+      /*
+       * Moves a value from a `parse_result` slot to the end of the column.
+       */
+      virtual void push(void* slot) = 0;
+
+      virtual void push_default(void const* default_value) = 0;
+
+      /*
+       * Moves all values of `other` column of the same type to the end.
+       */
+      virtual void append(column_base& other) = 0;
+
+      virtual void reserve(std::size_t size) = 0;
+
+      virtual ~column_base() {}
+    };
+
+    template <typename T>
+    class column : public column_base {
+    public:
+      virtual void push(void* slot) override {
+        values.push_back(std::move(*static_cast<T*>(slot)));
+      }
+
+      virtual void push_default(void const* default_value) override {
+        values.push_back(*static_cast<T const*>(default_value));
+      }
+
+      virtual void append(column_base& other) override {
+        auto& other_values = static_cast<column<T>&>(other).values;
+        values.insert(values.end(),
+                      std::make_move_iterator(other_values.begin()),
+                      std::make_move_iterator(other_values.end()));
+        other_values.clear();
+      }
+
+      virtual void reserve(std::size_t size) override { values.reserve(size); }
+
+      std::vector<T> values;
+    };
+
+    template <typename T>
+    std::unique_ptr<column_base> make_column() {
+      return std::make_unique<column<T>>();
+    }
+
+    /*
+     * Type erased option of a schema. A value of the option is placed in a
+     * `parse_result` storage at `offset`, and these functions construct it
+     * from a default value, destroy it and assign a converted string. The
+     * assignment returns false, if the string can not be converted.
+     */
+    struct option_record {
+      std::string_view lname;
+      std::string_view sname;
+      prefix_policy prefix;
+      option_kind kind;
+      bool mandatory;
+      std::size_t offset;
+      std::shared_ptr<void const> default_value;
+      void (*construct)(void* slot, void const* default_value);
+      void (*destroy)(void* slot) noexcept;
+      bool (*assign)(void* slot, std::string_view s);
+      std::unique_ptr<column_base> (*make_column)();
+    };
+
+    template <typename T>
+    void construct_slot(void* slot, void const* default_value) {
+      new (slot) T(*static_cast<T const*>(default_value));
+    }
+
+    template <typename T>
+    void destroy_slot(void* slot) noexcept {
+      static_cast<T*>(slot)->~T();
+    }
+
+    template <typename T>
+    bool assign_slot(void* slot, std::string_view s) {
+      return util::try_from_string(s, *static_cast<T*>(slot));
+    }
+
+    template <typename T>
+    bool append_slot(void* slot, std::string_view s) {
+      T value {};
+      if (!util::try_from_string(s, value)) return false;
+      static_cast<std::vector<T>*>(slot)->push_back(std::move(value));
+      return true;
+    }
+
+    inline bool toggle_slot(void* slot, std::string_view) {
+      bool& value = *static_cast<bool*>(slot);
+      value = !value;
+      return true;
+    }
+
+  } // namespace details
+
+  /*
+   * Values of options after a parsing of one command line with a `schema`.
+   *
+   * A result is bound to a schema, and it may be reused for several parses,
+   * keeping its storage. Each thread shall use its own result.
+   */
+  class parse_result {
+  public:
+    explicit parse_result(schema const& s);
+
+    parse_result(parse_result&& other) noexcept
+        : owner(other.owner), storage(std::move(other.storage)),
+          counts(std::move(other.counts)) {
+      other.owner = nullptr;
+    }
+
+    parse_result& operator=(parse_result&& other) noexcept {
+      if (this != &other) {
+        destroy();
+        owner = other.owner;
+        storage = std::move(other.storage);
+        counts = std::move(other.counts);
+        other.owner = nullptr;
+      }
+      return *this;
+    }
+
+    parse_result(parse_result const&) = delete;
+    parse_result& operator=(parse_result const&) = delete;
+
+    ~parse_result() { destroy(); }
+
+    template <typename T>
+    T const& get(option_key<T> key) const noexcept {
+      return *static_cast<T const*>(slot(key.id()));
+    }
+
+    /*
+     * Returns, how many times an option appeared in a command line.
+     */
+    template <typename T>
+    std::size_t count(option_key<T> key) const noexcept {
+      return counts[key.id()];
+    }
+
+    /*
+     * Sets all options to their default values.
+     */
+    void reset();
+
+  private:
+    friend class schema;
+
+    void* slot(std::size_t id) const noexcept;
+
+    void destroy() noexcept;
+
+    schema const* owner;
+    std::unique_ptr<std::max_align_t[]> storage;
+    std::vector<std::uint32_t> counts;
+  };
+
+  /*
+   * Error of a line of a batch. A code is `parse_errc::ok`, if the line is
+   * valid. Strings are views of the parsed lines or of unescaped arguments,
+   * which are kept by the result, and `index` is a position of an argument
+   * in its line. A line, which can not be split into arguments, has the
+   * `unterminated_quote` code, and its token is the whole line.
+   */
+  using batch_error = parse_error;
+
+  /*
+   * Results of a batch parsing in columns: an array of values per option
+   * and an array of errors, with one element per line. Options of invalid
+   * lines have default values.
+   */
+  class batch_result {
+  public:
+    std::size_t size() const noexcept { return errors.size(); }
+
+    template <typename T>
+    std::vector<T> const& column(option_key<T> key) const noexcept {
+      return static_cast<details::column<T> const&>(*columns[key.id()])
+          .values;
+    }
+
+    bool failed(std::size_t line) const noexcept {
+      return errors[line].code != parse_errc::ok;
+    }
+
+    batch_error const& error(std::size_t line) const noexcept {
+      return errors[line];
+    }
+
+    std::size_t failures() const noexcept { return failures_count; }
+
+  private:
+    friend class schema;
+
+    void append(batch_result& other) {
+      for (std::size_t i = 0; i < columns.size(); ++i)
+        columns[i]->append(*other.columns[i]);
+      errors.insert(errors.end(),
+                    std::make_move_iterator(other.errors.begin()),
+                    std::make_move_iterator(other.errors.end()));
+      failures_count += other.failures_count;
+    }
+
+    std::vector<std::unique_ptr<details::column_base>> columns;
+    std::vector<batch_error> errors;
+    std::size_t failures_count = 0;
+    // unescaped arguments of lines with quotes, values may refer to them
+    std::vector<std::unique_ptr<std::string>> unescaped;
+  };
+
+  /*
+   * Immutable set of options, split from parsing state.
+   *
+   * Options are added to a schema and then it is frozen. A frozen schema is
+   * not modified by parsing: each parse keeps its state on a stack and
+   * writes values to a `parse_result`, so one schema can parse many command
+   * lines from several threads at the same time without locks.
+   *
+   * Arguments are parsed with the loop of `command_line`, so prefix
+   * policies, attached values, bundles and errors are the same.
+   */
+  class schema {
+  public:
+    schema(std::string_view longname_prefix, std::string_view shortname_prefix)
+        : table(longname_prefix, shortname_prefix) {}
+
+    template <typename T>
+    option_key<T> add_value(std::string_view longname,
+                            std::string_view shortname,
+                            prefix_policy prefix = prefix_policy::optional,
+                            T default_value = T {}) {
+      return add<T>(longname, shortname, prefix, details::option_kind::value,
+                    false, std::move(default_value),
+                    &details::assign_slot<T>);
+    }
+
+    template <typename T>
+    option_key<std::vector<T>> add_multi(
+        std::string_view longname, std::string_view shortname,
+        prefix_policy prefix = prefix_policy::optional) {
+      return add<std::vector<T>>(longname, shortname, prefix,
+                                 details::option_kind::multi, false, {},
+                                 &details::append_slot<T>);
+    }
+
+    option_key<bool> add_switch(std::string_view longname,
+                                std::string_view shortname,
+                                prefix_policy prefix = prefix_policy::optional,
+                                bool default_value = false) {
+      return add<bool>(longname, shortname, prefix,
+                       details::option_kind::switch_, false, default_value,
+                       &details::toggle_slot);
+    }
+
+    template <typename T>
+    option_key<T> add_positional(bool is_mandatory = false,
+                                 T default_value = T {}) {
+      for (auto const& rec : records) {
+        if (rec.kind == details::option_kind::positional && !rec.mandatory &&
+            is_mandatory)
+          throw command_line_error("Mandatory positional argument can not "
+                                   "follow the not mandatory");
+      }
+      auto key = add<T>({}, {}, prefix_policy::optional,
+                        details::option_kind::positional, is_mandatory,
+                        std::move(default_value), &details::assign_slot<T>);
+      positionals.push_back(key.id());
+      return key;
+    }
+
+    /*
+     * Builds a names index. After that, the schema can not be changed and
+     * can be used for parsing.
+     */
+    void freeze() {
+      if (frozen) return;
+      table.reset(records.size());
+      for (auto const& rec : records)
+        table.add(rec.lname, rec.sname,
+                  { rec.prefix, rec.kind != details::option_kind::switch_ });
+      frozen = true;
+    }
+
+    bool is_frozen() const noexcept { return frozen; }
+
+    parse_result parse(std::vector<std::string_view> const& vec) const {
+      parse_result result(*this);
+      auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+      parse(begin, end, result);
+      return result;
+    }
+
+    parse_result parse(char** argv, int argc) const {
+      parse_result result(*this);
+      if (argc > 1) {
+        auto [begin, end] =
+            details::make_cursors<char*>(argv + 1, std::size_t(argc - 1));
+        parse(begin, end, result);
+      }
+      return result;
+    }
+
+    /*
+     * Parses a range of arguments into `result`, which is reset first.
+     *
+     * May throw exception of type `argument_error`.
+     */
+    void parse(details::arg_cursor begin, details::arg_cursor end,
+               parse_result& result) const {
+      parse_status status = try_parse(begin, end, result);
+      if (!status) details::throw_parse_error(status.error());
+    }
+
+    parse_status try_parse(std::vector<std::string_view> const& vec,
+                           parse_result& result) const {
+      auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+      return try_parse(begin, end, result);
+    }
+
+    /*
+     * Same as `parse`, but returns an error instead of throwing
+     * `argument_error`, see `command_line::try_parse`.
+     */
+    parse_status try_parse(details::arg_cursor begin, details::arg_cursor end,
+                           parse_result& result) const {
+      if (result.owner != this)
+        throw command_line_error("Result belongs to other schema");
+      result.reset();
+
+      details::parse_state st;
+      st.current = begin;
+      st.end = end;
+      st.active = true;
+      line_parser parser { *this, st, result };
+      return details::parse_loop(table, st, parser);
+    }
+
+    bool is_argument(std::string_view s) const noexcept {
+      return table.names().find(s).id != details::name_index::npos;
+    }
+
+    /*
+     * Parses many command lines at once into columns of a `batch_result`.
+     *
+     * An invalid line does not stop the batch, its error is stored in the
+     * result. Lines are divided between `threads` threads, each of them
+     * reuses one `parse_result` and one arguments vector for all its lines.
+     */
+    batch_result parse_batch(
+        std::vector<std::vector<std::string_view>> const& lines,
+        std::size_t threads = 1) const {
+      return run_batch(lines.size(), threads,
+                       [&](std::size_t i, std::vector<std::string_view>&,
+                           parse_status&)
+                           -> std::vector<std::string_view> const& {
+                         return lines[i];
+                       });
+    }
+
+    /*
+     * Parses a newline delimited buffer, one command line per line. Lines
+     * are split like `command_line::parse_line` does, see `details::unquote`
+     * for quoting rules. Arguments with quotes or escapes are unescaped into
+     * strings, which are kept by the result.
+     */
+    batch_result parse_batch(std::string_view buffer,
+                             std::size_t threads = 1) const {
+      std::vector<std::string_view> lines;
+      while (!buffer.empty()) {
+        auto eol = std::min(buffer.find('\n'), buffer.size());
+        lines.push_back(buffer.substr(0, eol));
+        buffer.remove_prefix(std::min(eol + 1, buffer.size()));
+      }
+      // each line is tokenized by one thread, so it owns its own element
+      std::vector<std::unique_ptr<std::string>> unescaped(lines.size());
+      auto res = run_batch(
+          lines.size(), threads,
+          [&](std::size_t i, std::vector<std::string_view>& vec,
+              parse_status& split) -> std::vector<std::string_view> const& {
+            vec.clear();
+            std::string_view line = lines[i];
+            if (line.find_first_of("\"'\\") == std::string_view::npos) {
+              // all arguments are views of the line
+              std::string unused;
+              details::tokenize(line, vec, unused);
+              return vec;
+            }
+            unescaped[i] = std::make_unique<std::string>();
+            try {
+              details::tokenize(line, vec, *unescaped[i]);
+            } catch (argument_error const&) {
+              // a quote is the only error of splitting
+              split = parse_error { parse_errc::unterminated_quote, line, 0,
+                                    {} };
+              vec.clear();
+            }
+            return vec;
+          });
+      unescaped.erase(
+          std::remove(unescaped.begin(), unescaped.end(), nullptr),
+          unescaped.end());
+      res.unescaped = std::move(unescaped);
+      return res;
+    }
+
+    std::string_view prefix_long() const noexcept {
+      return table.names().long_prefix();
+    }
+
+    std::string_view prefix_short() const noexcept {
+      return table.names().short_prefix();
+    }
+
+  private:
+    /*
+     * Parser of one command line for `details::parse_loop`, which writes
+     * values to a result.
+     */
+    struct line_parser {
+      schema const& owner;
+      details::parse_state& st;
+      parse_result& result;
+      std::size_t cur_pos = 0;
+
+      details::name_table::match find(std::string_view token) const noexcept {
+        return owner.table.names().find(token);
+      }
+
+      parse_errc parse_option(std::size_t id) {
+        details::option_record const& rec = owner.records[id];
+        auto& count = result.counts[id];
+        if (rec.kind == details::option_kind::value && count > 0)
+          return parse_errc::repeated_option;
+        ++count;
+        if (rec.kind == details::option_kind::switch_) {
+          // an attached value is left, it is an error of the loop
+          rec.assign(result.slot(id), {});
+          return parse_errc::ok;
+        }
+        if (st.attached) {
+          st.last_value = *st.attached;
+          st.attached.reset();
+        } else {
+          auto s = st.next();
+          if (!s || owner.is_argument(*s)) return parse_errc::value_required;
+          st.last_value = *s;
+        }
+        if (!rec.assign(result.slot(id), st.last_value))
+          return parse_errc::invalid_value;
+        return parse_errc::ok;
+      }
+
+      parse_errc parse_positional() {
+        if (cur_pos == owner.positionals.size())
+          return parse_errc::unrecognized_argument;
+        std::size_t id = owner.positionals[cur_pos++];
+        ++result.counts[id];
+        st.last_value = st.token;
+        if (!owner.records[id].assign(result.slot(id), st.token))
+          return parse_errc::invalid_value;
+        return parse_errc::ok;
+      }
+
+      bool positional_missing() const noexcept {
+        for (std::size_t i = cur_pos; i < owner.positionals.size(); ++i)
+          if (owner.records[owner.positionals[i]].mandatory) return true;
+        return false;
+      }
+
+      parse_error make_error(parse_errc code) const noexcept {
+        return st.error(code);
+      }
+    };
+
+    friend class parse_result;
+
+    batch_result make_batch_result() const {
+      batch_result res;
+      res.columns.reserve(records.size());
+      for (auto const& rec : records) res.columns.push_back(rec.make_column());
+      return res;
+    }
+
+    /*
+     * Parses lines from `first` to `last` into `res`. `get_line` returns
+     * arguments of a line, it may fill a given scratch vector. If a line
+     * can not be split into arguments, it sets an error of the line.
+     */
+    template <class GetLine>
+    void parse_lines(std::size_t first, std::size_t last, GetLine& get_line,
+                     batch_result& res) const {
+      parse_result scratch(*this);
+      std::vector<std::string_view> tokens;
+
+      for (auto& col : res.columns) col->reserve(last - first);
+      res.errors.reserve(last - first);
+
+      for (std::size_t i = first; i < last; ++i) {
+        parse_status status;
+        auto const& vec = get_line(i, tokens, status);
+        if (status) {
+          auto [begin, end] = details::make_cursors(vec.data(), vec.size());
+          status = try_parse(begin, end, scratch);
+        }
+        if (status) {
+          // a slot of an absent option holds a default value, which must
+          // stay valid for the next line
+          for (std::size_t k = 0; k < records.size(); ++k) {
+            if (scratch.counts[k] > 0) res.columns[k]->push(scratch.slot(k));
+            else res.columns[k]->push_default(records[k].default_value.get());
+          }
+        } else {
+          for (std::size_t k = 0; k < records.size(); ++k)
+            res.columns[k]->push_default(records[k].default_value.get());
+          ++res.failures_count;
+        }
+        res.errors.push_back(status.error());
+      }
+    }
+
+    template <class GetLine>
+    batch_result run_batch(std::size_t count, std::size_t threads,
+                           GetLine get_line) const {
+      if (!frozen) throw command_line_error("Schema is not frozen");
+      threads = std::max<std::size_t>(1, std::min(threads, count));
+
+      batch_result res = make_batch_result();
+      if (threads == 1) {
+        parse_lines(0, count, get_line, res);
+        return res;
+      }
+
+      std::vector<batch_result> parts;
+      std::vector<std::exception_ptr> exceptions(threads);
+      std::vector<std::thread> workers;
+      for (std::size_t t = 0; t < threads; ++t)
+        parts.push_back(make_batch_result());
+
+      std::size_t chunk = (count + threads - 1) / threads;
+      for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+          try {
+            std::size_t first = std::min(count, t * chunk);
+            std::size_t last = std::min(count, first + chunk);
+            parse_lines(first, last, get_line, parts[t]);
+          } catch (...) {
+            exceptions[t] = std::current_exception();
+          }
+        });
+      }
+      for (auto& w : workers) w.join();
+      for (auto& e : exceptions)
+        if (e) std::rethrow_exception(e);
+
+      for (auto& part : parts) res.append(part);
+      return res;
+    }
+
+    template <typename T>
+    option_key<T> add(std::string_view longname, std::string_view shortname,
+                      prefix_policy prefix, details::option_kind kind,
+                      bool mandatory, T default_value,
+                      bool (*assign)(void*, std::string_view)) {
+      static_assert(alignof(T) <= alignof(std::max_align_t),
+                    "Over-aligned option types are not supported");
+      if (frozen)
+        throw command_line_error("Option added to a frozen schema");
+
+      std::size_t offset =
+          (storage_size + alignof(T) - 1) / alignof(T) * alignof(T);
+      storage_size = offset + sizeof(T);
+
+      records.push_back(details::option_record {
+          longname, shortname, prefix, kind, mandatory, offset,
+          std::make_shared<T const>(std::move(default_value)),
+          &details::construct_slot<T>, &details::destroy_slot<T>, assign,
+          &details::make_column<T> });
+      return option_key<T>(records.size() - 1);
+    }
+
+    details::option_table table;
+    std::vector<details::option_record> records;
+    std::vector<std::size_t> positionals;
+    std::size_t storage_size = 0;
+    bool frozen = false;
+  };
+
+  inline parse_result::parse_result(schema const& s)
+      : owner(&s),
+        storage(new std::max_align_t[(s.storage_size +
+                                      sizeof(std::max_align_t) - 1) /
+                                     sizeof(std::max_align_t)]),
+        counts(s.records.size(), 0) {
+    if (!s.frozen) throw command_line_error("Schema is not frozen");
+    std::size_t i = 0;
+    try {
+      for (; i < s.records.size(); ++i) {
+        auto const& rec = s.records[i];
+        rec.construct(slot(i), rec.default_value.get());
+      }
+    } catch (...) {
+      while (i-- > 0) s.records[i].destroy(slot(i));
+      throw;
+    }
+  }
+
+  inline void parse_result::reset() {
+    for (std::size_t i = 0; i < owner->records.size(); ++i) {
+      auto const& rec = owner->records[i];
+      if (counts[i] == 0) continue;
+      rec.destroy(slot(i));
+      rec.construct(slot(i), rec.default_value.get());
+      counts[i] = 0;
+    }
+  }
+
+  inline void* parse_result::slot(std::size_t id) const noexcept {
+    return reinterpret_cast<unsigned char*>(storage.get()) +
+           owner->records[id].offset;
+  }
+
+  inline void parse_result::destroy() noexcept {
+    if (!owner) return;
+    for (std::size_t i = 0; i < owner->records.size(); ++i)
+      owner->records[i].destroy(slot(i));
+    owner = nullptr;
+  }
+
+} // namespace arg
+
+#endif
@@ -0,0 +1,523 @@
+#ifndef ARGUEME_STATIC_COMMAND_LINE_HPP
+#define ARGUEME_STATIC_COMMAND_LINE_HPP
+
+#include <algorithm>
+#include <argueme/arg.hpp>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace arg {
+
+  namespace details {
+
+    enum class static_kind { value, multi, switch_, positional };
+
+    template <class Option, class = void>
+    struct has_default_value : std::false_type {};
+
+    template <class Option>
+    struct has_default_value<Option,
+                             std::void_t<decltype(Option::default_value)>>
+        : std::true_type {};
+
+    /*
+     * Returns `Option::default_value`, if an option declares it, otherwise
+     * returns a value initialized `Option::value_type`.
+     */
+    template <class Option>
+    typename Option::value_type static_default() {
+      if constexpr (has_default_value<Option>::value)
+        return typename Option::value_type(Option::default_value);
+      else return typename Option::value_type {};
+    }
+
+    /*
+     * Returns, how many positional options are in `Options` before the
+     * option with index `I`.
+     */
+    template <std::size_t I, class... Options>
+    constexpr std::size_t positional_ordinal() {
+      constexpr std::array<bool, sizeof...(Options)> is_positional {
+        (Options::kind == static_kind::positional)...
+      };
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < I; ++i) n += is_positional[i];
+      return n;
+    }
+
+    /*
+     * Checks that a mandatory positional option does not follow a not
+     * mandatory one.
+     */
+    template <class... Options>
+    constexpr bool positional_order_valid() {
+      constexpr std::array<bool, sizeof...(Options)> is_positional {
+        (Options::kind == static_kind::positional)...
+      };
+      constexpr std::array<bool, sizeof...(Options)> is_mandatory {
+        Options::mandatory...
+      };
+      bool optional_seen = false;
+      for (std::size_t i = 0; i < sizeof...(Options); ++i) {
+        if (!is_positional[i]) continue;
+        if (is_mandatory[i] && optional_seen) return false;
+        if (!is_mandatory[i]) optional_seen = true;
+      }
+      return true;
+    }
+
+    template <class Option, class... Options>
+    constexpr std::size_t static_index_of() {
+      constexpr std::array<bool, sizeof...(Options)> same {
+        std::is_same_v<Option, Options>...
+      };
+      for (std::size_t i = 0; i < sizeof...(Options); ++i)
+        if (same[i]) return i;
+      return sizeof...(Options);
+    }
+
+    struct static_name {
+      std::string_view name;
+      std::size_t key = 0;
+      std::size_t id = 0;
+    };
+
+    /*
+     * Key of a name lookup: a length and a first character of a name.
+     */
+    constexpr std::size_t static_name_key(std::string_view name) noexcept {
+      return name.size() << 8 | static_cast<unsigned char>(name[0]);
+    }
+
+    template <class Option>
+    constexpr std::size_t static_name_count() {
+      if constexpr (Option::kind == static_kind::positional) return 0;
+      else return !Option::longname.empty() + !Option::shortname.empty();
+    }
+
+    template <class Option, std::size_t N>
+    constexpr void add_static_names(std::array<static_name, N>& names,
+                                    std::size_t& n, std::size_t id) {
+      if constexpr (Option::kind != static_kind::positional) {
+        for (std::string_view name : { Option::longname, Option::shortname })
+          if (!name.empty()) names[n++] = { name, static_name_key(name), id };
+      }
+    }
+
+    /*
+     * Names of `Options`, sorted by a key and then by a name at compile
+     * time. Equal names keep the order of options, so the first option
+     * with a name is found.
+     */
+    template <class... Options>
+    constexpr auto make_static_names() {
+      constexpr std::size_t count = (static_name_count<Options>() + ... + 0);
+      std::array<static_name, count> names {};
+      std::size_t n = 0;
+      std::size_t id = 0;
+      (add_static_names<Options>(names, n, id++), ...);
+
+      auto less = [](static_name const& a, static_name const& b) {
+        return a.key < b.key || (a.key == b.key && a.name < b.name);
+      };
+      for (std::size_t i = 1; i < count; ++i) {
+        for (std::size_t j = i; j > 0 && less(names[j], names[j - 1]); --j) {
+          static_name tmp = names[j];
+          names[j] = names[j - 1];
+          names[j - 1] = tmp;
+        }
+      }
+      return names;
+    }
+
+  } // namespace details
+
+  /*
+   * Option descriptors of `static_command_line`. A user declares an option as
+   * a struct, derived from one of these, with `longname` and `shortname`
+   * static constexpr `std::string_view` members and, optionally, with a
+   * `default_value` member:
+   *
+   * ```
+   * struct threads : arg::static_value<int> {
+   *   static constexpr std::string_view longname = "threads";
+   *   static constexpr std::string_view shortname = "t";
+   *   static constexpr int default_value = 1;
+   * };
+   * ```
+   *
+   * Descriptors have the same semantics as `value_argument`,
+   * `multi_argument`, `switch_argument` and `positional_argument`.
+   */
+  template <typename T, prefix_policy Prefix = prefix_policy::optional>
+  struct static_value {
+    using value_type = T;
+    static constexpr details::static_kind kind = details::static_kind::value;
+    static constexpr prefix_policy prefix = Prefix;
+    static constexpr bool mandatory = false;
+  };
+
+  template <typename T, prefix_policy Prefix = prefix_policy::optional>
+  struct static_multi {
+    using value_type = std::vector<T>;
+    using element_type = T;
+    static constexpr details::static_kind kind = details::static_kind::multi;
+    static constexpr prefix_policy prefix = Prefix;
+    static constexpr bool mandatory = false;
+  };
+
+  template <prefix_policy Prefix = prefix_policy::optional>
+  struct static_switch {
+    using value_type = bool;
+    static constexpr details::static_kind kind =
+        details::static_kind::switch_;
+    static constexpr prefix_policy prefix = Prefix;
+    static constexpr bool mandatory = false;
+  };
+
+  template <typename T, bool Mandatory = false>
+  struct static_positional {
+    using value_type = T;
+    static constexpr details::static_kind kind =
+        details::static_kind::positional;
+    static constexpr bool mandatory = Mandatory;
+  };
+
+  /*
+   * Command line, which option set is known at compile time.
+   *
+   * Names are sorted at compile time by a length and a first character, so
+   * a lookup is a binary search of these keys and compares only names with
+   * the same key. Each option is handled by its own instantiated code, so a
+   * parse loop has no virtual calls and allocates nothing, except
+   * `static_multi` value storage. Prefix policies and errors are the same,
+   * as in `command_line`.
+   */
+  template <class... Options>
+  class static_command_line {
+    static_assert(details::positional_order_valid<Options...>(),
+                  "Mandatory positional argument can not follow the not "
+                  "mandatory");
+
+    static constexpr std::size_t npos = details::name_index::npos;
+
+  public:
+    static_command_line(std::string_view longname_prefix,
+                        std::string_view shortname_prefix)
+        : values(details::static_default<Options>()...),
+          longname_p(longname_prefix), shortname_p(shortname_prefix) {}
+
+    void parse(std::vector<std::string_view> const& vec) {
+      parse(vec.cbegin(), vec.cend());
+    }
+
+    void parse(std::vector<std::string> const& vec) {
+      parse(vec.cbegin(), vec.cend());
+    }
+
+    void parse(char** argv, int argc) {
+      if (argc < 1) return;
+      parse(argv + 1, argv + argc);
+    }
+
+    /*
+     * Parses a range of strings, which elements are convertible to
+     * `std::string_view`.
+     *
+     * May throw exception of type `argument_error`.
+     */
+    template <class Iterator>
+    void parse(Iterator begin, Iterator end) {
+      auto status = try_parse(begin, end);
+      if (!status) details::throw_parse_error(status.error());
+    }
+
+    parse_status try_parse(std::vector<std::string_view> const& vec) {
+      return try_parse(vec.cbegin(), vec.cend());
+    }
+
+    parse_status try_parse(std::vector<std::string> const& vec) {
+      return try_parse(vec.cbegin(), vec.cend());
+    }
+
+    parse_status try_parse(char** argv, int argc) {
+      if (argc < 1) return {};
+      return try_parse(argv + 1, argv + argc);
+    }
+
+    /*
+     * Same as `parse`, but returns an error instead of throwing
+     * `argument_error`, see `command_line::try_parse`. Values are kept
+     * between parses, but a value option may be given again by a next
+     * parse, same as in `command_line`.
+     */
+    template <class Iterator>
+    parse_status try_parse(Iterator begin, Iterator end) {
+      constexpr auto seq = std::index_sequence_for<Options...> {};
+      activated.fill(false);
+      std::size_t cur_pos = 0;
+      std::size_t index = 0;
+
+      for (Iterator current = begin; current != end; ++current, ++index) {
+        std::string_view token = *current;
+        std::size_t token_index = index;
+        auto [name, has_prefix] =
+            details::remove_prefix(token, longname_p, shortname_p);
+        std::size_t id = find(name);
+        attached.reset();
+        if (id == npos && has_prefix) id = find_attached(token, name);
+
+        parse_errc code = parse_errc::ok;
+        if (id != npos) {
+          if (!check_prefix(id, has_prefix)) code = parse_errc::prefix_error;
+          else code = handle(id, current, end, index, seq);
+          if (code == parse_errc::ok && attached)
+            code = parse_errc::unexpected_value;
+        } else if (parse_bundle(token, current, end, index, code)) {
+        } else if (cur_pos < positional_count) {
+          code = handle_positional(cur_pos, token, seq);
+          ++cur_pos;
+        } else code = parse_errc::unrecognized_argument;
+
+        if (code != parse_errc::ok) {
+          std::string_view value;
+          if (code == parse_errc::invalid_value) value = last_value;
+          return parse_error { code, token, token_index, value };
+        }
+      }
+
+      for (; cur_pos < positional_count; ++cur_pos) {
+        if (positional_mandatory(cur_pos, seq))
+          return parse_error { parse_errc::positional_required, {}, index,
+                               {} };
+      }
+      return {};
+    }
+
+    /*
+     * Checks if `s` is an option name, same as `command_line_impl`.
+     */
+    bool is_argument(std::string_view s) const noexcept {
+      auto name = details::remove_prefix(s, longname_p, shortname_p).first;
+      return find(name) != npos;
+    }
+
+    template <class Option>
+    typename Option::value_type const& get() const noexcept {
+      constexpr std::size_t i = details::static_index_of<Option, Options...>();
+      static_assert(i != sizeof...(Options),
+                    "Option is not declared in a command line");
+      return std::get<i>(values);
+    }
+
+    std::string_view prefix_long() const noexcept { return longname_p; }
+
+    std::string_view prefix_short() const noexcept { return shortname_p; }
+
+  private:
+    static constexpr std::size_t positional_count =
+        ((Options::kind == details::static_kind::positional) + ... + 0);
+
+    template <std::size_t I>
+    using option_at = std::tuple_element_t<I, std::tuple<Options...>>;
+
+    static constexpr auto sorted_names =
+        details::make_static_names<Options...>();
+
+    static std::size_t find(std::string_view name) noexcept {
+      if (name.empty()) return npos;
+      std::size_t key = details::static_name_key(name);
+      auto it = std::lower_bound(
+          sorted_names.begin(), sorted_names.end(), key,
+          [](details::static_name const& e, std::size_t k) {
+            return e.key < k;
+          });
+      for (; it != sorted_names.end() && it->key == key; ++it)
+        if (it->name == name) return it->id;
+      return npos;
+    }
+
+    template <std::size_t... I>
+    static bool takes_value(std::size_t id,
+                            std::index_sequence<I...>) noexcept {
+      return ((id == I &&
+               (option_at<I>::kind == details::static_kind::value ||
+                option_at<I>::kind == details::static_kind::multi)) ||
+              ...);
+    }
+
+    /*
+     * Splits an option name and an attached value, see
+     * `details::split_attached`. Stores the value in `attached` and returns
+     * an option index.
+     */
+    std::size_t find_attached(std::string_view token,
+                              std::string_view name) noexcept {
+      auto match = details::split_attached(
+          token, name, longname_p,
+          [](std::string_view n) { return find(n); },
+          [](std::size_t id) {
+            return takes_value(id, std::index_sequence_for<Options...> {});
+          });
+      if (match.id != npos) attached = match.value;
+      return match.id;
+    }
+
+    /*
+     * Parses a bundle of short names, see `details::split_bundle`. Each
+     * short name is found with the same unrolled comparisons, as a whole
+     * name.
+     */
+    template <class Iterator>
+    bool parse_bundle(std::string_view token, Iterator& current, Iterator end,
+                      std::size_t& index, parse_errc& code) {
+      auto [chars, has_prefix] =
+          details::remove_prefix(token, longname_p, shortname_p);
+      if (!has_prefix || details::starts_with(token, longname_p))
+        return false;
+      return details::split_bundle(
+          chars, [](char c) { return find(std::string_view(&c, 1)); },
+          [](std::size_t id) {
+            return takes_value(id, std::index_sequence_for<Options...> {});
+          },
+          [&](std::size_t id, std::optional<std::string_view> rest) {
+            if (!check_prefix(id, true)) {
+              code = parse_errc::prefix_error;
+              return false;
+            }
+            attached = rest;
+            code = handle(id, current, end, index,
+                          std::index_sequence_for<Options...> {});
+            return code == parse_errc::ok;
+          });
+    }
+
+    template <std::size_t I>
+    static constexpr bool check_prefix_at(bool has_prefix) noexcept {
+      using Option = option_at<I>;
+      if constexpr (Option::kind == details::static_kind::positional)
+        return true;
+      else return details::check_prefix(Option::prefix, has_prefix);
+    }
+
+    bool check_prefix(std::size_t id, bool has_prefix) const noexcept {
+      return check_prefix_impl(id, has_prefix,
+                               std::index_sequence_for<Options...> {});
+    }
+
+    template <std::size_t... I>
+    static bool check_prefix_impl(std::size_t id, bool has_prefix,
+                                  std::index_sequence<I...>) noexcept {
+      bool res = true;
+      (void) ((id == I ? (res = check_prefix_at<I>(has_prefix), true)
+                       : false) ||
+              ...);
+      return res;
+    }
+
+    template <class Iterator, std::size_t... I>
+    parse_errc handle(std::size_t id, Iterator& current, Iterator end,
+                      std::size_t& index, std::index_sequence<I...>) {
+      parse_errc code = parse_errc::ok;
+      (void) ((id == I ? (code = handle_at<I>(current, end, index), true)
+                       : false) ||
+              ...);
+      return code;
+    }
+
+    /*
+     * Takes a value attached to an option or following it. If there is no
+     * value or the value is an option name, returns nothing.
+     */
+    template <class Iterator>
+    std::optional<std::string_view>
+        take_value(Iterator& current, Iterator end, std::size_t& index) {
+      if (attached) {
+        auto value = attached;
+        attached.reset();
+        return value;
+      }
+      if (++current == end || is_argument(*current)) return std::nullopt;
+      ++index;
+      return std::string_view(*current);
+    }
+
+    template <class T>
+    parse_errc convert(std::string_view s, T& res) {
+      if (util::try_from_string(s, res)) return parse_errc::ok;
+      last_value = s;
+      return parse_errc::invalid_value;
+    }
+
+    template <std::size_t I, class Iterator>
+    parse_errc handle_at(Iterator& current, Iterator end, std::size_t& index) {
+      using Option = option_at<I>;
+      auto& value = std::get<I>(values);
+
+      if constexpr (Option::kind == details::static_kind::value) {
+        if (activated[I]) return parse_errc::repeated_option;
+        activated[I] = true;
+        auto s = take_value(current, end, index);
+        if (!s) return parse_errc::value_required;
+        return convert(*s, value);
+      } else if constexpr (Option::kind == details::static_kind::multi) {
+        auto s = take_value(current, end, index);
+        if (!s) return parse_errc::value_required;
+        typename Option::element_type elem {};
+        parse_errc code = convert(*s, elem);
+        if (code == parse_errc::ok) value.push_back(std::move(elem));
+        return code;
+      } else if constexpr (Option::kind == details::static_kind::switch_) {
+        value = !value;
+      }
+      return parse_errc::ok;
+    }
+
+    template <std::size_t... I>
+    parse_errc handle_positional(std::size_t ordinal, std::string_view token,
+                                 std::index_sequence<I...>) {
+      parse_errc code = parse_errc::ok;
+      (void) ((is_positional_at<I>(ordinal)
+                   ? (code = assign_positional<I>(token), true)
+                   : false) ||
+              ...);
+      return code;
+    }
+
+    template <std::size_t I>
+    static constexpr bool is_positional_at(std::size_t ordinal) noexcept {
+      return option_at<I>::kind == details::static_kind::positional &&
+             details::positional_ordinal<I, Options...>() == ordinal;
+    }
+
+    template <std::size_t I>
+    parse_errc assign_positional(std::string_view token) {
+      if constexpr (option_at<I>::kind == details::static_kind::positional)
+        return convert(token, std::get<I>(values));
+      else return parse_errc::ok;
+    }
+
+    template <std::size_t... I>
+    static bool positional_mandatory(std::size_t ordinal,
+                                     std::index_sequence<I...>) noexcept {
+      return ((is_positional_at<I>(ordinal) && option_at<I>::mandatory) ||
+              ...);
+    }
+
+    std::tuple<typename Options::value_type...> values;
+    std::array<bool, sizeof...(Options)> activated {};
+    std::optional<std::string_view> attached;
+    std::string_view last_value;
+    std::string_view longname_p;
+    std::string_view shortname_p;
+  };
+
+} // namespace arg
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef ARGUEME_TOKEN_STREAM_HPP
+#define ARGUEME_TOKEN_STREAM_HPP
+
+#include <argueme/arg.hpp>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace arg {
+
+  enum class token_separator {
+    whitespace, // any whitespace, like `xargs`
+    newline,    // one argument per line, like `xargs -d '\n'`
+    null        // arguments are terminated by '\0', like `xargs -0`
+  };
+
+  /*
+   * Single pass source of arguments, which are read incrementally from a
+   * file descriptor, `FILE*` or `std::istream`.
+   *
+   * Input is read in chunks into a fixed buffer, each argument is copied into
+   * one of a few rotating slots, so memory does not depend on an input
+   * length, only on the longest argument. Arguments are parsed as soon as
+   * they arrive, use `multi_argument::on_value` to consume values without
+   * accumulating them.
+   *
+   * Views of arguments are valid only until a few more arguments are read,
+   * so `std::string_view` values must not be kept, and errors must be
+   * handled before the stream is read further. Empty arguments are skipped.
+   *
+   * A read error ends the stream, and a parse of it returns
+   * `parse_errc::read_error`, values before the error are parsed.
+   */
+  class token_stream {
+  public:
+    using cursor_t = details::arg_cursor;
+
+#if ARGUEME_HAS_POSIX_IO
+    explicit token_stream(int fd,
+                          token_separator sep = token_separator::whitespace,
+                          std::size_t buffer_size = 1 << 16)
+        : token_stream(sep, buffer_size) {
+      file_descriptor = fd;
+      reader = &read_fd;
+    }
+#endif
+
+    explicit token_stream(std::FILE* file,
+                          token_separator sep = token_separator::whitespace,
+                          std::size_t buffer_size = 1 << 16)
+        : token_stream(sep, buffer_size) {
+      c_file = file;
+      reader = &read_file;
+    }
+
+    explicit token_stream(std::istream& is,
+                          token_separator sep = token_separator::whitespace,
+                          std::size_t buffer_size = 1 << 16)
+        : token_stream(sep, buffer_size) {
+      stream = &is;
+      reader = &read_stream;
+    }
+
+    token_stream(token_stream const&) = delete;
+    token_stream& operator=(token_stream const&) = delete;
+
+    /*
+     * Reads the first argument and returns cursors over all arguments. The
+     * cursors refer to the stream, so they are valid while it is alive.
+     */
+    std::pair<cursor_t, cursor_t> cursors() {
+      cursor_t end(this, npos, ops);
+      if (!read_token()) return { end, end };
+      return { cursor_t(this, 0, ops), end };
+    }
+
+    /*
+     * Returns true, if reading has failed. The stream ends at a failure.
+     */
+    bool failed() const noexcept { return error; }
+
+    std::size_t arguments_count() const noexcept { return count; }
+
+  private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    // a parser accesses the current argument and an option before it
+    static constexpr std::size_t slots_count = 4;
+
+    token_stream(token_separator sep, std::size_t buffer_size)
+        : separator(sep), capacity(buffer_size > 0 ? buffer_size : 1),
+          buffer(new char[capacity]) {}
+
+    static std::string_view fetch(void const* source,
+                                  std::size_t pos) noexcept {
+      auto self = static_cast<token_stream const*>(source);
+      return self->slots[pos % slots_count];
+    }
+
+    static std::size_t advance(void const* source, std::size_t pos) {
+      // a source is const for cursors, but the stream is read by them
+      auto self = const_cast<token_stream*>(
+          static_cast<token_stream const*>(source));
+      if (pos == npos || !self->read_token()) return npos;
+      return pos + 1;
+    }
+
+    // arguments read before an error are parsed first
+    static bool read_failed(void const* source) noexcept {
+      auto self = static_cast<token_stream const*>(source);
+      return self->error && self->ended;
+    }
+
+    bool is_separator(char c) const noexcept {
+      switch (separator) {
+        case token_separator::whitespace: return details::is_space(c);
+        case token_separator::newline: return c == '\n';
+        case token_separator::null: return c == '\0';
+      }
+      return false;
+    }
+
+    /*
+     * Reads the next argument into a next slot. Returns false at the end of
+     * input or on a read error. May throw `std::bad_alloc`, if an argument
+     * does not fit a slot.
+     */
+    bool read_token() {
+      std::string& slot = slots[count % slots_count];
+      slot.clear();
+      while (true) {
+        if (pos == filled && !fill()) {
+          ended = true;
+          return false;
+        }
+        while (pos < filled && is_separator(buffer[pos])) ++pos;
+        if (pos < filled) break;
+      }
+      while (true) {
+        std::size_t start = pos;
+        while (pos < filled && !is_separator(buffer[pos])) ++pos;
+        slot.append(buffer.get() + start, pos - start);
+        if (pos < filled) {
+          ++pos;
+          break;
+        }
+        if (!fill()) break;
+      }
+      ++count;
+      return true;
+    }
+
+    bool fill() {
+      pos = 0;
+      filled = 0;
+      if (error) return false;
+      filled = reader(*this);
+      return filled > 0;
+    }
+
+#if ARGUEME_HAS_POSIX_IO
+    static std::size_t read_fd(token_stream& self) noexcept {
+      while (true) {
+        ssize_t n = ::read(self.file_descriptor, self.buffer.get(),
+                           self.capacity);
+        if (n >= 0) return static_cast<std::size_t>(n);
+        if (errno != EINTR) {
+          self.error = true;
+          return 0;
+        }
+      }
+    }
+#endif
+
+    /*
+     * Buffered streams are read until a newline, so a line is parsed as
+     * soon as it arrives.
+     */
+    static std::size_t read_file(token_stream& self) noexcept {
+      std::size_t n = 0;
+      while (n < self.capacity) {
+        int c = std::getc(self.c_file);
+        if (c == EOF) {
+          self.error = std::ferror(self.c_file) != 0;
+          break;
+        }
+        self.buffer[n++] = static_cast<char>(c);
+        if (c == '\n') break;
+      }
+      return n;
+    }
+
+    static std::size_t read_stream(token_stream& self) noexcept {
+      std::streambuf* buf = self.stream->rdbuf();
+      std::size_t n = 0;
+      try {
+        while (n < self.capacity) {
+          auto c = buf->sbumpc();
+          if (std::char_traits<char>::eq_int_type(
+                  c, std::char_traits<char>::eof()))
+            break;
+          self.buffer[n++] = std::char_traits<char>::to_char_type(c);
+          if (self.buffer[n - 1] == '\n') break;
+        }
+      } catch (...) {
+        self.error = true;
+      }
+      return n;
+    }
+
+    static constexpr details::cursor_source ops { &fetch, &advance, true,
+                                                  &read_failed };
+
+    token_separator separator;
+    std::size_t capacity;
+    std::unique_ptr<char[]> buffer;
+    std::size_t pos = 0;
+    std::size_t filled = 0;
+    std::array<std::string, slots_count> slots;
+    std::size_t count = 0;
+    bool error = false;
+    bool ended = false;
+
+    std::size_t (*reader)(token_stream&) noexcept = nullptr;
+    int file_descriptor = -1;
+    std::FILE* c_file = nullptr;
+    std::istream* stream = nullptr;
+  };
+
+} // namespace arg
+
+#endif
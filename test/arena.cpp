@@ -0,0 +1,74 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Arena storage") {
+  arg::command_line cmd("--", "-");
+
+  SECTION("Values are allocated in an arena") {
+    arg::pmr_multi_argument<std::pmr::string> inc("include", "I", cmd);
+    std::vector<std::string_view> vec { "-I", "a-long-path-of-an-include",
+                                        "-Ib", "--include=c" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+
+    auto const& values = inc.get();
+    REQUIRE(values.size() == 3);
+    REQUIRE(values[0] == "a-long-path-of-an-include");
+    REQUIRE(values[1] == "b");
+    REQUIRE(values[2] == "c");
+
+    auto* arena = values.get_allocator().resource();
+    REQUIRE(arena != std::pmr::get_default_resource());
+    REQUIRE(values[0].get_allocator().resource() == arena);
+  }
+
+  SECTION("Values of a previous parse are dropped") {
+    arg::pmr_multi_argument<int> num("num", "n", cmd);
+    std::vector<std::string_view> first { "-n", "1", "-n", "2" };
+    std::vector<std::string_view> second { "-n", "3" };
+
+    cmd.parse(first);
+    REQUIRE(num.get().size() == 2);
+    cmd.parse(second);
+    REQUIRE(num.get().size() == 1);
+    REQUIRE(num.get()[0] == 3);
+  }
+
+  SECTION("Invalid value is not appended") {
+    arg::pmr_multi_argument<int> num("num", "n", cmd);
+    std::vector<std::string_view> vec { "-n", "1", "-n", "x" };
+
+    REQUIRE_FALSE(cmd.try_parse(vec));
+    REQUIRE(num.get().size() == 1);
+  }
+
+  SECTION("Arena and ordinary arguments are mixed") {
+    arg::pmr_multi_argument<std::pmr::string> inc("include", "I", cmd);
+    arg::multi_argument<bool> flags("flag", "f", cmd);
+    std::vector<std::string_view> vec { "-I", "a", "-f", "yes", "-I", "b" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(inc.get().size() == 2);
+    REQUIRE(flags.get() == std::vector<bool> { true });
+  }
+}
+
+TEST_CASE("Values are reserved in advance") {
+  arg::command_line cmd("--", "-");
+  cmd.reserve_values();
+  arg::multi_argument<std::string> inc("include", "I", cmd);
+  arg::pmr_multi_argument<int> num("num", "n", cmd);
+
+  std::vector<std::string_view> vec;
+  for (int i = 0; i < 100; ++i) {
+    vec.push_back("-I");
+    vec.push_back("path");
+    vec.push_back("-n5");
+  }
+
+  REQUIRE_NOTHROW(cmd.parse(vec));
+  REQUIRE(inc.get().size() == 100);
+  REQUIRE(inc.get().capacity() == 100);
+  REQUIRE(num.get().size() == 100);
+  REQUIRE(num.get().capacity() == 100);
+}
@@ -0,0 +1,178 @@
+#include <argueme/arg.hpp>
+#include <argueme/schema.hpp>
+#include <argueme/static_command_line.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Attached values") {
+  arg::command_line cmd("--", "-");
+
+  SECTION("Value is attached to a long name with '='") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+
+    std::vector<std::string_view> vec { "--jobs=8" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(jobs.get() == 8);
+  }
+
+  SECTION("Value is attached to a short name") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+
+    std::vector<std::string_view> vec { "-j8" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(jobs.get() == 8);
+  }
+
+  SECTION("Value is attached to a short name with '='") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+
+    std::vector<std::string_view> vec { "-j=8" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(jobs.get() == 8);
+  }
+
+  SECTION("Attached value may look like an option") {
+    arg::value_argument<std::string> define("define", "D", cmd);
+    arg::switch_argument verbose("verbose", "v", cmd);
+
+    std::vector<std::string_view> vec { "--define=--verbose" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(define.get() == "--verbose");
+    REQUIRE(verbose.get() == false);
+  }
+
+  SECTION("Attached value may be empty or contain '='") {
+    arg::multi_argument<std::string> define("define", "D", cmd);
+
+    std::vector<std::string_view> vec { "--define=", "-DKEY=VALUE" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(define.get() == std::vector<std::string> { "", "KEY=VALUE" });
+  }
+
+  SECTION("Attached and separate values are mixed") {
+    arg::multi_argument<std::string> include("include", "I", cmd);
+
+    std::vector<std::string_view> vec { "-Ia", "-I", "b", "--include=c",
+                                        "--include", "d" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(include.get() == std::vector<std::string> { "a", "b", "c", "d" });
+  }
+
+  SECTION("Option name with '=' takes precedence") {
+    arg::switch_argument weird("a=b", "", cmd);
+    arg::value_argument<std::string> a("a", "", cmd);
+
+    std::vector<std::string_view> vec { "--a=b" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(weird.get() == true);
+  }
+
+  SECTION("Switch does not take a value") {
+    arg::switch_argument verbose("verbose", "v", cmd);
+
+    std::vector<std::string_view> vec { "--verbose=yes" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Short switch is not split") {
+    arg::switch_argument verbose("verbose", "v", cmd);
+
+    std::vector<std::string_view> vec { "-vx" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Long name is not split without '='") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+
+    std::vector<std::string_view> vec { "--jobs8" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Token without a prefix is not split") {
+    arg::value_argument<std::string> key("key", "k", cmd);
+    arg::positional_argument<std::string> pos(cmd);
+
+    std::vector<std::string_view> vec { "key=value" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(pos.get() == "key=value");
+  }
+
+  SECTION("Attached value respects a prefix policy") {
+    arg::value_argument<int> jobs("jobs", "j", cmd,
+                                  arg::prefix_policy::do_not_require);
+
+    std::vector<std::string_view> vec { "--jobs=8" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+}
+
+TEST_CASE("Attached values in schema") {
+  arg::schema s("--", "-");
+  auto jobs = s.add_value<int>("jobs", "j");
+  auto include = s.add_multi<std::string>("include", "I");
+  s.add_switch("verbose", "v");
+  s.freeze();
+
+  SECTION("Values are attached") {
+    std::vector<std::string_view> vec { "--jobs=4", "-Ia", "-I=b" };
+    auto res = s.parse(vec);
+
+    REQUIRE(res.get(jobs) == 4);
+    REQUIRE(res.get(include) == std::vector<std::string> { "a", "b" });
+  }
+
+  SECTION("Switch does not take a value") {
+    std::vector<std::string_view> vec { "--verbose=1" };
+
+    REQUIRE_THROWS_AS(s.parse(vec), arg::argument_error);
+  }
+}
+
+namespace {
+
+  struct jobs : arg::static_value<int> {
+    static constexpr std::string_view longname = "jobs";
+    static constexpr std::string_view shortname = "j";
+  };
+
+  struct verbose : arg::static_switch<> {
+    static constexpr std::string_view longname = "verbose";
+    static constexpr std::string_view shortname = "v";
+  };
+
+} // namespace
+
+TEST_CASE("Attached values in static_command_line") {
+  arg::static_command_line<jobs, verbose> cmd("--", "-");
+
+  SECTION("Value is attached to a long name") {
+    std::vector<std::string_view> vec { "--jobs=3" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(cmd.get<jobs>() == 3);
+  }
+
+  SECTION("Value is attached to a short name") {
+    std::vector<std::string_view> vec { "-j3" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(cmd.get<jobs>() == 3);
+  }
+
+  SECTION("Switch does not take a value") {
+    std::vector<std::string_view> vec { "--verbose=1" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+}
@@ -0,0 +1,138 @@
+#include <argueme/arg.hpp>
+#include <argueme/schema.hpp>
+#include <argueme/static_command_line.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Bundled short names") {
+  arg::command_line cmd("--", "-");
+  arg::switch_argument x("extract", "x", cmd);
+  arg::switch_argument v("verbose", "v", cmd);
+  arg::value_argument<std::string> f("file", "f", cmd);
+
+  SECTION("Switches are toggled") {
+    std::vector<std::string_view> vec { "-xv" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(x.get() == true);
+    REQUIRE(v.get() == true);
+  }
+
+  SECTION("Repeated switch is toggled twice") {
+    std::vector<std::string_view> vec { "-xvx" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(x.get() == false);
+    REQUIRE(v.get() == true);
+  }
+
+  SECTION("Last option takes the next argument") {
+    std::vector<std::string_view> vec { "-xvf", "archive.tar" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(x.get() == true);
+    REQUIRE(f.get() == "archive.tar");
+  }
+
+  SECTION("Option with a value takes the rest of a bundle") {
+    std::vector<std::string_view> vec { "-vfarchive.tar" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(v.get() == true);
+    REQUIRE(x.get() == false);
+    REQUIRE(f.get() == "archive.tar");
+  }
+
+  SECTION("Last option requires a value") {
+    std::vector<std::string_view> vec { "-xf" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Unknown character is not a bundle") {
+    std::vector<std::string_view> vec { "-xq" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+    REQUIRE(x.get() == false);
+  }
+
+  SECTION("Long prefix is not a bundle") {
+    std::vector<std::string_view> vec { "--xv" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Bundle is not taken from a positional argument") {
+    arg::positional_argument<std::string> pos(cmd);
+    std::vector<std::string_view> vec { "xv" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(pos.get() == "xv");
+    REQUIRE(x.get() == false);
+  }
+
+  SECTION("Bundled option respects a prefix policy") {
+    arg::switch_argument n("no-prefix", "n", cmd,
+                           arg::prefix_policy::do_not_require);
+    std::vector<std::string_view> vec { "-xn" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+}
+
+TEST_CASE("Bundled short names in schema") {
+  arg::schema s("--", "-");
+  auto x = s.add_switch("extract", "x");
+  auto v = s.add_switch("verbose", "v");
+  auto f = s.add_value<std::string>("file", "f");
+  s.freeze();
+
+  SECTION("Switches and a value") {
+    std::vector<std::string_view> vec { "-xvf", "a.tar" };
+    auto res = s.parse(vec);
+
+    REQUIRE(res.get(x) == true);
+    REQUIRE(res.get(v) == true);
+    REQUIRE(res.get(f) == "a.tar");
+  }
+
+  SECTION("Value is the rest of a bundle") {
+    std::vector<std::string_view> vec { "-xfa.tar" };
+    auto res = s.parse(vec);
+
+    REQUIRE(res.get(x) == true);
+    REQUIRE(res.get(f) == "a.tar");
+  }
+}
+
+namespace {
+
+  struct extract : arg::static_switch<> {
+    static constexpr std::string_view longname = "extract";
+    static constexpr std::string_view shortname = "x";
+  };
+
+  struct file : arg::static_value<std::string> {
+    static constexpr std::string_view longname = "file";
+    static constexpr std::string_view shortname = "f";
+  };
+
+} // namespace
+
+TEST_CASE("Bundled short names in static_command_line") {
+  arg::static_command_line<extract, file> cmd("--", "-");
+
+  SECTION("Switch and a value") {
+    std::vector<std::string_view> vec { "-xf", "a.tar" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(cmd.get<extract>() == true);
+    REQUIRE(cmd.get<file>() == "a.tar");
+  }
+
+  SECTION("Value is the rest of a bundle") {
+    std::vector<std::string_view> vec { "-xfa.tar" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(cmd.get<file>() == "a.tar");
+  }
+}
@@ -1,5 +1,9 @@
 #include <argueme/arg.hpp>
+#include <argueme/async.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <future>
+#include <stdexcept>
 
 using svvec_t = std::vector<std::string_view>;
 
@@ -33,6 +37,18 @@ TEST_CASE("Commands") {
     REQUIRE(called == true);
   }
 
+  SECTION("Error of a command gets a name of the option") {
+    arg::command convert("convert", "c", cmd,
+                         [] { arg::util::from_string<int>("x"); });
+    svvec_t vec { "--convert" };
+    try {
+      cmd.parse(vec);
+      FAIL("argument_error must be thrown");
+    } catch (arg::argument_error const& e) {
+      REQUIRE(std::string_view(e.argname()) == "--convert");
+    }
+  }
+
   SECTION("Deffered execution") {
     bool called1 = false;
     bool called2 = false;
@@ -54,4 +70,52 @@ TEST_CASE("Commands") {
     CHECK(called1 == true);
     CHECK(called2 == true);
   }
+  SECTION("Asynchronous execution overlaps with parsing") {
+    std::promise<void> parsed;
+    auto signal = parsed.get_future();
+    bool overlapped = false;
+
+    // the task waits for a command, which is parsed after it
+    arg::command warm(
+        "warm", "w", cmd,
+        [&] {
+          overlapped = signal.wait_for(std::chrono::seconds(1)) ==
+                       std::future_status::ready;
+        },
+        arg::async_execution {});
+    arg::command done("done", "d", cmd, [&] { parsed.set_value(); });
+
+    svvec_t vec { "--warm", "--done" };
+    cmd.parse(vec);
+    cmd.wait_commands();
+    CHECK(overlapped == true);
+  }
+
+  SECTION("Functor returns a future") {
+    std::promise<int> loaded;
+    arg::command load(
+        "load", "l", cmd, [&] { return loaded.get_future(); },
+        arg::async_execution {});
+
+    svvec_t vec { "--load" };
+    cmd.parse(vec);
+    loaded.set_value(1);
+    REQUIRE_NOTHROW(cmd.wait_commands());
+  }
+
+  SECTION("Exception of a task is rethrown after all tasks") {
+    bool called = false;
+    arg::command fail(
+        "fail", "f", cmd, [] { throw std::runtime_error("fail"); },
+        arg::async_execution {});
+    arg::command fp("function", "F", cmd,
+                    arg::util::callable_wrapper(&function, called),
+                    arg::async_execution {});
+
+    svvec_t vec { "--fail", "--function" };
+    cmd.parse(vec);
+    REQUIRE_THROWS_AS(cmd.wait_commands(), std::runtime_error);
+    CHECK(called == true);
+    REQUIRE_NOTHROW(cmd.wait_commands());
+  }
 }
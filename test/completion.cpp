@@ -0,0 +1,88 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <sstream>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("Completion queries") {
+  arg::command_line cmd("--", "-");
+  arg::switch_argument verbose("verbose", "v", cmd);
+  arg::value_argument<int> jobs("jobs", "j", cmd);
+  arg::switch_argument version("version", "", cmd);
+  arg::switch_argument run("run", "", cmd, arg::prefix_policy::do_not_require);
+
+  SECTION("Names are matched by a prefix in order") {
+    REQUIRE(cmd.complete("--ver") == svvec_t { "--verbose", "--version" });
+    REQUIRE(cmd.complete("--j") == svvec_t { "--jobs" });
+    REQUIRE(cmd.complete("-") ==
+            svvec_t { "--jobs", "--verbose", "--version", "-j", "-v" });
+    REQUIRE(cmd.complete("--x").empty());
+  }
+
+  SECTION("Name without a prefix is completed bare") {
+    REQUIRE(cmd.complete("r") == svvec_t { "run" });
+    REQUIRE(cmd.complete("--r").empty());
+  }
+
+  SECTION("Index is rebuilt, when arguments change") {
+    REQUIRE(cmd.complete("--q").empty());
+    arg::switch_argument quiet("quiet", "q", cmd);
+    REQUIRE(cmd.complete("--q") == svvec_t { "--quiet" });
+  }
+
+  SECTION("Query is answered") {
+    char prog[] = "prog";
+    char query[] = "__complete";
+    char partial[] = "--ver";
+    char* argv[] = { prog, query, partial };
+
+    std::ostringstream os;
+    REQUIRE(cmd.complete(argv, 3, os));
+    REQUIRE(os.str() == "--verbose\n--version\n");
+  }
+
+  SECTION("Other arguments are not a query") {
+    char prog[] = "prog";
+    char arg[] = "--verbose";
+    char* argv[] = { prog, arg };
+
+    std::ostringstream os;
+    REQUIRE_FALSE(cmd.complete(argv, 2, os));
+    REQUIRE(os.str().empty());
+  }
+}
+
+TEST_CASE("Completion scripts") {
+  arg::command_line cmd("--", "-");
+  arg::switch_argument verbose("verbose", "v", cmd);
+  verbose.add_description("Prints what's done");
+  arg::value_argument<int> jobs("jobs", "j", cmd);
+  arg::switch_argument run("run", "", cmd, arg::prefix_policy::do_not_require);
+
+  auto contains = [](std::string const& s, std::string_view part) {
+    return s.find(part) != std::string::npos;
+  };
+
+  SECTION("bash") {
+    auto s = cmd.completion_script(arg::completion_shell::bash, "my-tool");
+    REQUIRE(contains(s, "compgen -W '--verbose -v --jobs -j run'"));
+    REQUIRE(contains(s, "complete -o default -F _my_tool 'my-tool'"));
+  }
+
+  SECTION("zsh") {
+    auto s = cmd.completion_script(arg::completion_shell::zsh, "tool");
+    REQUIRE(contains(s, "#compdef tool\n"));
+    REQUIRE(contains(s, "'--verbose:Prints what'\\''s done'"));
+    REQUIRE(contains(s, "'--jobs'"));
+    REQUIRE(contains(s, "compdef _tool 'tool'"));
+  }
+
+  SECTION("fish") {
+    auto s = cmd.completion_script(arg::completion_shell::fish, "tool");
+    REQUIRE(contains(s, "complete -c 'tool' -l 'verbose' -s 'v' -d "
+                        "'Prints what\\'s done'\n"));
+    REQUIRE(contains(s, "complete -c 'tool' -l 'jobs' -s 'j' -r\n"));
+    REQUIRE(contains(s, "complete -c 'tool' -f -a 'run'\n"));
+  }
+}
@@ -0,0 +1,63 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("Names index") {
+  arg::command_line cmd("--", "-");
+
+  SECTION("Many arguments are found by long and short names") {
+    std::vector<std::string> lnames;
+    std::vector<std::string> snames;
+    for (int i = 0; i < 500; ++i) {
+      lnames.push_back("option" + std::to_string(i));
+      snames.push_back("o" + std::to_string(i));
+    }
+
+    std::vector<arg::value_argument<int>> opts;
+    opts.reserve(lnames.size());
+    for (std::size_t i = 0; i < lnames.size(); ++i)
+      opts.emplace_back(lnames[i], snames[i], cmd);
+
+    cmd.freeze();
+
+    svvec_t vec { "--option0", "1", "-o250", "2", "--option499", "3" };
+    cmd.parse(vec);
+
+    CHECK(opts[0].get() == 1);
+    CHECK(opts[250].get() == 2);
+    CHECK(opts[499].get() == 3);
+    CHECK(opts[1].get() == 0);
+  }
+
+  SECTION("Argument attached after parsing is found") {
+    arg::switch_argument first("first", "f", cmd);
+
+    svvec_t vec1 { "--first" };
+    cmd.parse(vec1);
+    CHECK(first.get() == true);
+
+    arg::switch_argument second("second", "s", cmd);
+
+    svvec_t vec2 { "-s" };
+    cmd.parse(vec2);
+    CHECK(second.get() == true);
+  }
+
+  SECTION("Empty short name is not an argument name") {
+    arg::switch_argument first("first", "", cmd);
+
+    svvec_t vec { "-" };
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Optional positional argument may be omitted") {
+    arg::switch_argument sw("switch", "s", cmd);
+    arg::positional_argument<std::string> pos(cmd);
+
+    svvec_t vec { "--switch" };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    CHECK(sw.get() == true);
+  }
+}
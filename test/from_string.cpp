@@ -0,0 +1,103 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstdint>
+#include <istream>
+#include <limits>
+
+using arg::util::from_string;
+
+namespace {
+
+  struct point {
+    int x = 0;
+    int y = 0;
+  };
+
+  std::istream& operator>>(std::istream& is, point& p) {
+    char comma;
+    is >> p.x >> comma >> p.y;
+    if (comma != ',') is.setstate(std::ios::failbit);
+    return is;
+  }
+
+} // namespace
+
+TEST_CASE("from_string") {
+  SECTION("Integers") {
+    CHECK(from_string<int>("123") == 123);
+    CHECK(from_string<int>("-123") == -123);
+    CHECK(from_string<int>("+7") == 7);
+    CHECK(from_string<int>("010") == 10);
+    CHECK(from_string<long long>("-9223372036854775808") ==
+          std::numeric_limits<long long>::min());
+    CHECK(from_string<std::uint64_t>("18446744073709551615") ==
+          std::numeric_limits<std::uint64_t>::max());
+    CHECK(from_string<short>("-32768") == -32768);
+
+    REQUIRE_THROWS_AS(from_string<int>(""), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<int>("-"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<int>("12a"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<int>(" 12"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<int>("--1"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<short>("32768"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<unsigned>("-1"), arg::argument_error);
+  }
+
+  SECTION("Integer base prefixes") {
+    CHECK(from_string<int>("0x1F") == 31);
+    CHECK(from_string<int>("0XfF") == 255);
+    CHECK(from_string<int>("-0x10") == -16);
+    CHECK(from_string<int>("0b101") == 5);
+    CHECK(from_string<unsigned>("0o17") == 15);
+
+    REQUIRE_THROWS_AS(from_string<int>("0x"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<int>("0b2"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<int>("0x-1"), arg::argument_error);
+  }
+
+  SECTION("Floating point numbers") {
+    CHECK_THAT(from_string<double>("3.14"),
+               Catch::Matchers::WithinRel(3.14));
+    CHECK_THAT(from_string<float>("-1e3"),
+               Catch::Matchers::WithinRel(-1000.0f));
+    CHECK_THAT(from_string<double>("+.5"), Catch::Matchers::WithinRel(0.5));
+    CHECK(from_string<double>("inf") ==
+          std::numeric_limits<double>::infinity());
+
+    REQUIRE_THROWS_AS(from_string<double>("3.14.1"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<double>("1e"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<double>("+-1"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<float>("1e100"), arg::argument_error);
+  }
+
+  SECTION("Booleans") {
+    CHECK(from_string<bool>("1") == true);
+    CHECK(from_string<bool>("true") == true);
+    CHECK(from_string<bool>("Yes") == true);
+    CHECK(from_string<bool>("ON") == true);
+    CHECK(from_string<bool>("0") == false);
+    CHECK(from_string<bool>("false") == false);
+    CHECK(from_string<bool>("no") == false);
+    CHECK(from_string<bool>("off") == false);
+
+    REQUIRE_THROWS_AS(from_string<bool>("2"), arg::argument_error);
+    REQUIRE_THROWS_AS(from_string<bool>("truth"), arg::argument_error);
+  }
+
+  SECTION("Characters and strings") {
+    CHECK(from_string<char>("c") == 'c');
+    REQUIRE_THROWS_AS(from_string<char>("cc"), arg::argument_error);
+
+    std::string_view s = "hello";
+    CHECK(from_string<std::string_view>(s).data() == s.data());
+    CHECK(from_string<std::string>(s) == "hello");
+  }
+
+  SECTION("Types with operator>>") {
+    point p = from_string<point>("1,2");
+    CHECK(p.x == 1);
+    CHECK(p.y == 2);
+    REQUIRE_THROWS_AS(from_string<point>("1;2"), arg::argument_error);
+  }
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+TEST_CASE("Help text") {
+  arg::command_line cmd("--", "-");
+  arg::switch_argument verbose("verbose", "v", cmd);
+  verbose.add_description("Prints more");
+  arg::value_argument<int> jobs("jobs", "", cmd);
+  jobs.add_description("Number of jobs");
+
+  std::string const expected =
+      "-v, --verbose                 Prints more\n"
+      "--jobs                        Number of jobs\n";
+
+  SECTION("Names are aligned to a column") {
+    REQUIRE(cmd.help() == expected);
+  }
+
+  SECTION("Description lines have no null characters") {
+    auto lines = cmd.description();
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines[0] == "-v, --verbose                 Prints more");
+    REQUIRE(lines[1].find('\0') == std::string::npos);
+  }
+
+  SECTION("Long names are followed by a new line") {
+    arg::switch_argument lng("an-even-longer-option-name", "l", cmd);
+    lng.add_description("Long");
+
+    auto text = cmd.help();
+    REQUIRE(text.find("-l, --an-even-longer-option-name\n" +
+                      std::string(30, ' ') + "Long\n") !=
+            std::string_view::npos);
+  }
+
+  SECTION("Descriptions are wrapped by words") {
+    verbose.add_description("one two three four five six");
+
+    std::string indent(30, ' ');
+    REQUIRE(cmd.help(44) == "-v, --verbose                 one two three\n" +
+                                indent + "four five six\n" +
+                                "--jobs                        Number of "
+                                "jobs\n");
+  }
+
+  SECTION("Word longer than a line is not broken") {
+    verbose.add_description("abcdefghijklmnop qr");
+
+    REQUIRE(cmd.help(40).substr(0, 60) ==
+            "-v, --verbose                 abcdefghijklmnop\n" +
+                std::string(13, ' '));
+  }
+
+  SECTION("Zero width disables wrapping") {
+    verbose.add_description(
+        "a description, which is much longer than eighty columns of the "
+        "terminal, where it is printed");
+
+    auto text = cmd.help(0);
+    REQUIRE(std::count(text.begin(), text.end(), '\n') == 2);
+  }
+
+  SECTION("Text is cached") {
+    auto first = cmd.help();
+    auto second = cmd.help();
+    REQUIRE(first.data() == second.data());
+    REQUIRE(first == expected);
+  }
+
+  SECTION("Cache is updated, when arguments change") {
+    REQUIRE(cmd.help() == expected);
+    verbose.add_description("Prints everything");
+    REQUIRE(cmd.help().find("Prints everything") != std::string_view::npos);
+
+    arg::switch_argument quiet("quiet", "q", cmd);
+    REQUIRE(cmd.help().find("-q, --quiet") != std::string_view::npos);
+  }
+
+  SECTION("Text is written to a stream") {
+    std::ostringstream os;
+    cmd.write_help(os);
+    REQUIRE(os.str() == expected);
+  }
+
+  SECTION("Text is written to a file") {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    REQUIRE(cmd.write_help(file));
+    std::rewind(file);
+    std::string read(expected.size() + 1, '\0');
+    read.resize(std::fread(read.data(), 1, read.size(), file));
+    std::fclose(file);
+    REQUIRE(read == expected);
+  }
+}
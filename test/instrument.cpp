@@ -0,0 +1,100 @@
+#define ARGUEME_INSTRUMENT 1
+
+#include <argueme/arg.hpp>
+#include <argueme/scheduler.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <thread>
+
+TEST_CASE("Instrumentation") {
+  arg::command_line cmd("--", "-");
+  arg::value_argument<int> i("int", "i", cmd);
+  arg::multi_argument<std::string> m("multi", "m", cmd);
+  arg::switch_argument s("switch", "s", cmd);
+
+  SECTION("Lookups and conversions are counted") {
+    std::vector<std::string_view> vec { "-i", "1", "-m", "a", "-m", "b",
+                                        "-s" };
+    cmd.parse(vec);
+
+    auto const& stats = cmd.stats();
+    // each option is looked up once, each value is checked to be an option
+    REQUIRE(stats.lookup.count == 7);
+    REQUIRE(stats.conversion(arg::conversion_kind::integer).count == 1);
+    REQUIRE(stats.conversion(arg::conversion_kind::string).count == 2);
+    REQUIRE(stats.conversion(arg::conversion_kind::floating).count == 0);
+    REQUIRE(stats.errors == 0);
+  }
+
+  SECTION("Errors are counted") {
+    std::vector<std::string_view> bad { "--unknown" };
+
+    REQUIRE_FALSE(cmd.try_parse(bad));
+    REQUIRE_THROWS(cmd.parse(bad));
+    REQUIRE(cmd.stats().errors == 2);
+
+    cmd.reset_stats();
+    REQUIRE(cmd.stats().errors == 0);
+    REQUIRE(cmd.stats().lookup.count == 0);
+  }
+
+  SECTION("Commands and help are measured") {
+    int calls = 0;
+    arg::command instant("instant", "", cmd, [&] { ++calls; });
+    arg::command deferred("deferred", "", cmd, [&] { ++calls; },
+                          arg::deferred_execution {});
+    std::vector<std::string_view> vec { "--instant", "--deferred" };
+
+    cmd.parse(vec);
+    REQUIRE(cmd.stats().commands.count == 1);
+    deferred.execute();
+    REQUIRE(cmd.stats().commands.count == 2);
+    REQUIRE(calls == 2);
+
+    cmd.description();
+    REQUIRE(cmd.stats().help.count == 1);
+  }
+
+  SECTION("Commands on many threads are counted") {
+    int observed = 0;
+    cmd.observe([&](arg::parse_event const& e) {
+      if (e.phase == arg::parse_phase::command) ++observed;
+    });
+    // both commands finish together, so their records overlap
+    std::atomic<int> arrived { 0 };
+    auto meet = [&] {
+      ++arrived;
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(1);
+      while (arrived < 2 && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::yield();
+    };
+    arg::command a("a", "", cmd, meet, arg::deferred_execution {});
+    arg::command b("b", "", cmd, meet, arg::deferred_execution {});
+    std::vector<std::string_view> vec { "--a", "--b" };
+    cmd.parse(vec);
+
+    arg::scheduler sched(2);
+    sched.add(a);
+    sched.add(b);
+    sched.execute();
+    REQUIRE(cmd.stats().commands.count == 2);
+    REQUIRE(observed == 2);
+  }
+
+  SECTION("Observer receives measurements") {
+    std::vector<arg::parse_event> events;
+    cmd.observe([&](arg::parse_event const& e) { events.push_back(e); });
+    std::vector<std::string_view> vec { "--int", "42" };
+
+    cmd.parse(vec);
+
+    REQUIRE(events.size() == 3);
+    REQUIRE(events[0].phase == arg::parse_phase::lookup);
+    REQUIRE(events[0].token == "--int");
+    REQUIRE(events[2].phase == arg::parse_phase::conversion);
+    REQUIRE(events[2].kind == arg::conversion_kind::integer);
+    REQUIRE(events[2].token == "42");
+  }
+}
@@ -0,0 +1,137 @@
+#include <argueme/arg.hpp>
+#include <argueme/layers.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("Environment and config file layers") {
+  arg::command_line cmd("--", "-");
+  arg::value_argument<int> port("port", "p", cmd);
+  port.bind_env("APP_PORT");
+  port.bind_config("server.port");
+  arg::value_argument<std::string_view> host("host", "", cmd);
+  host.bind_env("APP_HOST");
+  host.bind_config("server.host");
+  arg::switch_argument debug("debug", "d", cmd);
+  debug.bind_env("APP_DEBUG");
+  debug.bind_config("debug");
+
+  char port_var[] = "APP_PORT=8080";
+  char other_var[] = "PATH=/usr/bin";
+  char debug_var[] = "APP_DEBUG=true";
+  char* envp[] = { other_var, port_var, debug_var, nullptr };
+
+  std::string config = "# settings\n"
+                       "debug = false\n"
+                       "[server]\n"
+                       "port = 7000\n"
+                       "host = \"example.org\"\n"
+                       "  ; comment\n";
+
+  SECTION("Command line overrides other layers") {
+    cmd.use_environment(envp);
+    cmd.use_config(config);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t { "--port", "1" }));
+    REQUIRE(port.get() == 1);
+    REQUIRE(port.source() == arg::value_source::command_line);
+  }
+
+  SECTION("Environment overrides a config file") {
+    cmd.use_environment(envp);
+    cmd.use_config(config);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    REQUIRE(port.get() == 8080);
+    REQUIRE(port.source() == arg::value_source::environment);
+    REQUIRE(host.get() == "example.org");
+    REQUIRE(host.source() == arg::value_source::config_file);
+    REQUIRE(debug.get() == true);
+    REQUIRE(debug.source() == arg::value_source::environment);
+  }
+
+  SECTION("Config values are views of a text") {
+    cmd.use_config(config);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    REQUIRE(port.get() == 7000);
+    REQUIRE(debug.get() == false);
+    REQUIRE(debug.source() == arg::value_source::config_file);
+    REQUIRE(host.get().data() >= config.data());
+    REQUIRE(host.get().data() < config.data() + config.size());
+  }
+
+  SECTION("Argument without a value has no source") {
+    REQUIRE_NOTHROW(cmd.parse(svvec_t { "-d" }));
+    REQUIRE(port.source() == arg::value_source::none);
+    REQUIRE(debug.source() == arg::value_source::command_line);
+  }
+
+  SECTION("Switch is set, not toggled") {
+    arg::switch_argument color("color", "", cmd,
+                               arg::prefix_policy::optional, true);
+    color.bind_env("APP_COLOR");
+    char color_var[] = "APP_COLOR=true";
+    char* color_envp[] = { color_var, debug_var, nullptr };
+    cmd.use_environment(color_envp);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    REQUIRE(color.get());
+    REQUIRE(color.source() == arg::value_source::environment);
+  }
+
+  SECTION("Layers are applied again by a next parse") {
+    cmd.use_environment(envp);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    REQUIRE(port.get() == 8080);
+    REQUIRE(debug.get());
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    REQUIRE(port.get() == 8080);
+    REQUIRE(debug.get());
+    REQUIRE(port.source() == arg::value_source::environment);
+  }
+
+  SECTION("Invalid value is reported with a variable name") {
+    char bad_var[] = "APP_PORT=http";
+    char* bad_envp[] = { bad_var, nullptr };
+    cmd.use_environment(bad_envp);
+
+    auto status = cmd.try_parse(svvec_t {});
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().token == "APP_PORT");
+    REQUIRE(status.error().value == "http");
+  }
+
+  SECTION("Process environment is used by default") {
+    REQUIRE(::setenv("APP_PORT", "9090", 1) == 0);
+    arg::use_process_environment(cmd);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    ::unsetenv("APP_PORT");
+    REQUIRE(port.get() == 9090);
+  }
+
+  SECTION("Config file is loaded") {
+    auto path = std::filesystem::temp_directory_path() / "argueme_layers.ini";
+    std::ofstream(path) << config;
+    arg::config_file file(cmd, path.string());
+    std::filesystem::remove(path);
+
+    REQUIRE_NOTHROW(cmd.parse(svvec_t {}));
+    REQUIRE(port.get() == 7000);
+    REQUIRE(host.get() == "example.org");
+  }
+
+  SECTION("Missing config file") {
+    REQUIRE_THROWS_AS(arg::config_file(cmd, "/nonexistent/argueme.ini"),
+                      arg::argument_error);
+  }
+}
@@ -0,0 +1,101 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+
+TEST_CASE("Lazy conversion") {
+  arg::command_line cmd("--", "-");
+  cmd.lazy_conversion();
+
+  SECTION("Value is converted on access") {
+    arg::value_argument<int> jobs("jobs", "j", cmd,
+                                  arg::prefix_policy::optional, 1);
+    arg::multi_argument<int> level("level", "l", cmd);
+
+    std::vector<std::string_view> vec { "--jobs", "8", "-l1", "-l", "2" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(jobs.get() == 8);
+    REQUIRE(level.get() == std::vector<int> { 1, 2 });
+  }
+
+  SECTION("Default value is kept") {
+    arg::value_argument<int> jobs("jobs", "j", cmd,
+                                  arg::prefix_policy::optional, 1);
+
+    std::vector<std::string_view> vec {};
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(jobs.get() == 1);
+  }
+
+  SECTION("Invalid value is reported on access") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+
+    std::vector<std::string_view> vec { "--jobs", "many" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE_THROWS_AS(jobs.get(), arg::argument_error);
+    REQUIRE_THROWS_AS(jobs.get(), arg::argument_error);
+  }
+
+  SECTION("Missing value is reported by parse") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+
+    std::vector<std::string_view> vec { "--jobs" };
+
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Validate reports the first invalid value") {
+    arg::value_argument<int> jobs("jobs", "j", cmd);
+    arg::multi_argument<int> level("level", "l", cmd);
+
+    std::vector<std::string_view> vec { "-j", "4", "-l1", "-lx", "-l3" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    auto status = cmd.validate();
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().token == "-lx");
+    REQUIRE(status.error().index == 3);
+    REQUIRE(status.error().value == "x");
+    REQUIRE(jobs.get() == 4);
+    REQUIRE_THROWS_AS(level.get(), arg::argument_error);
+  }
+
+  SECTION("Validate succeeds for valid values") {
+    arg::value_argument<double> ratio("ratio", "r", cmd);
+
+    std::vector<std::string_view> vec { "--ratio=0.5" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(cmd.validate());
+    REQUIRE(ratio.get() == 0.5);
+  }
+
+  SECTION("Views of a previous parse are dropped") {
+    arg::value_argument<int> jobs("jobs", "j", cmd,
+                                  arg::prefix_policy::optional, 1);
+    arg::multi_argument<int> level("level", "l", cmd);
+    arg::list_argument<int> ids("ids", "i", cmd);
+
+    {
+      std::vector<std::string> args { "--jobs", "5", "-l", "2", "-i1,2" };
+      REQUIRE_NOTHROW(cmd.parse(args));
+    }
+    REQUIRE_NOTHROW(cmd.parse(std::vector<std::string_view> {}));
+    REQUIRE(jobs.get() == 1);
+    REQUIRE(level.get().empty());
+    REQUIRE(ids.get().empty());
+  }
+
+  SECTION("Eager conversion is the default") {
+    arg::command_line eager("--", "-");
+    arg::value_argument<int> jobs("jobs", "j", eager);
+
+    std::vector<std::string_view> vec { "--jobs", "many" };
+
+    REQUIRE_THROWS_AS(eager.parse(vec), arg::argument_error);
+  }
+}
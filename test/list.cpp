@@ -0,0 +1,85 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <string_view>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("List argument") {
+  arg::command_line cmd("--", "-");
+
+  SECTION("Value is split on a delimiter") {
+    arg::list_argument<int> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids", "1,2,3" };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(ids.get() == std::vector<int> { 1, 2, 3 });
+  }
+
+  SECTION("Elements of all values are appended") {
+    arg::list_argument<int, ':'> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids=1:2", "-i3", "-i", "", "--ids", "4" };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(ids.get() == std::vector<int> { 1, 2, 3, 4 });
+  }
+
+  SECTION("Long list is split") {
+    std::string value;
+    std::vector<long> expected;
+    for (long i = 0; i < 1000; ++i) {
+      if (i > 0) value += ',';
+      value += std::to_string(i * 7);
+      expected.push_back(i * 7);
+    }
+    arg::list_argument<long> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids", value };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(ids.get() == expected);
+  }
+
+  SECTION("String views refer to the argument") {
+    arg::list_argument<std::string_view> tags("tags", "t", cmd);
+
+    std::string value = "a,,bc,";
+    svvec_t vec { "--tags", value };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(tags.get() == svvec_t { "a", "", "bc", "" });
+    REQUIRE(tags.get()[2].data() == value.data() + 3);
+  }
+
+  SECTION("Invalid element") {
+    arg::list_argument<int> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids", "1,2", "--ids", "3,x,4" };
+    auto status = cmd.try_parse(vec);
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().value == "3,x,4");
+    REQUIRE(ids.get() == std::vector<int> { 1, 2 });
+  }
+
+  SECTION("Empty element is invalid for numbers") {
+    arg::list_argument<int> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids", "1,,2" };
+    REQUIRE_THROWS(cmd.parse(vec));
+  }
+
+  SECTION("Value is required") {
+    arg::list_argument<int> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids" };
+    REQUIRE_THROWS(cmd.parse(vec));
+  }
+
+  SECTION("Lazily parsed value is split on access") {
+    cmd.lazy_conversion();
+    arg::list_argument<int> ids("ids", "i", cmd);
+
+    svvec_t vec { "--ids", "5,x" };
+    REQUIRE(cmd.try_parse(vec));
+    REQUIRE_THROWS_AS(ids.get(), arg::argument_error);
+  }
+}
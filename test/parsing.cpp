@@ -25,3 +25,88 @@ TEST_CASE("Stopping parsing") {
 
   SUCCEED("foo command stops parsing process");
 }
+
+TEST_CASE("Parsing a remainder of a command line") {
+  arg::command_line cmd("--", "-");
+  arg::command_line subcmd("--", "-");
+
+  arg::switch_argument verbose("verbose", "v", subcmd);
+  arg::value_argument<int> count("count", "c", subcmd);
+
+  auto run_lambda = [&]() {
+    cmd.stop();
+    auto [begin, end] = cmd.get_iterator();
+    subcmd.parse(++begin, end);
+  };
+
+  arg::command run("run", "r", cmd, arg::util::callable_wrapper(run_lambda));
+
+  char prog[] = "prog";
+  char run_arg[] = "run";
+  char verbose_arg[] = "-v";
+  char count_arg[] = "--count";
+  char count_value[] = "3";
+  char* argv[] = { prog, run_arg, verbose_arg, count_arg, count_value };
+
+  cmd.parse(argv, 5);
+
+  CHECK(verbose.get() == true);
+  CHECK(count.get() == 3);
+}
+
+TEST_CASE("Parsing a vector of strings") {
+  arg::command_line cmd("--", "-");
+  arg::value_argument<std::string_view> name("name", "n", cmd);
+
+  std::vector<std::string> vec { "--name", "value" };
+  cmd.parse(vec);
+
+  CHECK(name.get() == "value");
+  CHECK(name.get().data() == vec[1].data());
+}
+
+namespace {
+
+  /*
+   * Attaches itself as a `counter`, but `parse` may be overridden further.
+   */
+  class counter : public arg::details::named_argument {
+  public:
+    counter(std::string_view longname, arg::command_line& cmdline)
+        : arg::details::named_argument(longname, {}) {
+      cmdline.attach(*this);
+    }
+
+    virtual arg::parse_errc parse(arg::details::command_line_impl&) override {
+      ++count;
+      return arg::parse_errc::ok;
+    }
+
+    int count = 0;
+  };
+
+  class double_counter : public counter {
+  public:
+    using counter::counter;
+
+    virtual arg::parse_errc parse(arg::details::command_line_impl&) override {
+      count += 2;
+      return arg::parse_errc::ok;
+    }
+  };
+
+} // namespace
+
+TEST_CASE("Custom arguments are parsed by their overrides") {
+  arg::command_line cmd("--", "-");
+  counter once("once", cmd);
+  double_counter twice("twice", cmd);
+  arg::switch_argument flag("flag", "f", cmd);
+
+  svvec_t vec { "--once", "--twice", "-f", "--twice" };
+  cmd.parse(vec);
+
+  REQUIRE(once.count == 1);
+  REQUIRE(twice.count == 4);
+  REQUIRE(flag.get());
+}
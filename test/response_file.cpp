@@ -0,0 +1,109 @@
+#include <argueme/arg.hpp>
+#include <argueme/response_files.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+namespace {
+
+  /*
+   * Writes a file to a temporary directory and returns `@path`.
+   */
+  std::string make_response_file(std::string const& name,
+                                 std::string const& contents) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream(path, std::ios::binary) << contents;
+    return "@" + path.string();
+  }
+
+} // namespace
+
+TEST_CASE("Response files") {
+  arg::command_line cmd("--", "-");
+  arg::response_files responses(cmd);
+
+  arg::multi_argument<std::string_view> include("include", "I", cmd);
+  arg::value_argument<std::string_view> define("define", "D", cmd);
+  arg::switch_argument verbose("verbose", "v", cmd);
+
+  SECTION("Arguments are read from a file") {
+    auto rsp = make_response_file("argueme_simple.rsp",
+                                  "-I a\n  --include\tb\n# -I comment\n-v");
+    std::vector<std::string> vec { "-I", "first", rsp, "-I", "last" };
+    cmd.parse(vec);
+
+    CHECK(include.get() == svvec_t { "first", "a", "b", "last" });
+    CHECK(verbose.get() == true);
+  }
+
+  SECTION("Quotes and escapes") {
+    auto rsp = make_response_file(
+        "argueme_quotes.rsp",
+        "-I 'single quoted' -I \"double \\\"quoted\\\"\" -I escaped\\ space "
+        "-D \"\"");
+    svvec_t vec { rsp };
+    cmd.parse(vec);
+
+    CHECK(include.get() ==
+          svvec_t { "single quoted", "double \"quoted\"", "escaped space" });
+    CHECK(define.get() == "");
+  }
+
+  SECTION("Nested response files") {
+    auto inner = make_response_file("argueme_inner.rsp", "-I inner");
+    auto outer =
+        make_response_file("argueme_outer.rsp", "-I outer " + inner + " -v");
+    svvec_t vec { outer };
+    cmd.parse(vec);
+
+    CHECK(include.get() == svvec_t { "outer", "inner" });
+    CHECK(verbose.get() == true);
+  }
+
+  SECTION("Files of a previous parse are unmapped") {
+    auto inner = make_response_file("argueme_inner.rsp", "-I inner");
+    auto outer = make_response_file("argueme_outer.rsp", "-I outer " + inner);
+    svvec_t vec { outer };
+    cmd.parse(vec);
+    CHECK(responses.size() == 2);
+    cmd.parse(vec);
+    CHECK(responses.size() == 2);
+    // values of the first parse point into unmapped files
+    REQUIRE(include.get().size() == 4);
+    CHECK(include.get()[2] == "outer");
+    CHECK(include.get()[3] == "inner");
+
+    cmd.parse(svvec_t { "-v" });
+    CHECK(responses.size() == 0);
+  }
+
+  SECTION("Recursive response file") {
+    auto path = std::filesystem::temp_directory_path() / "argueme_self.rsp";
+    auto rsp = make_response_file("argueme_self.rsp", "@" + path.string());
+    svvec_t vec { rsp };
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Unterminated quote") {
+    auto rsp = make_response_file("argueme_unterminated.rsp", "-I 'a");
+    svvec_t vec { rsp };
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Nonexistent response file") {
+    svvec_t vec { "@argueme_nonexistent.rsp" };
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+}
+
+TEST_CASE("Response files are disabled by default") {
+  arg::command_line cmd("--", "-");
+  arg::positional_argument<std::string> pos(cmd);
+
+  svvec_t vec { "@file" };
+  cmd.parse(vec);
+  CHECK(pos.get() == "@file");
+}
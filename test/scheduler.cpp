@@ -0,0 +1,210 @@
+#include <argueme/scheduler.hpp>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using svvec_t = std::vector<std::string_view>;
+
+namespace {
+
+  /*
+   * Log of executed commands, shared by threads.
+   */
+  struct journal {
+    void write(std::string s) {
+      std::lock_guard<std::mutex> lock(m);
+      entries.push_back(std::move(s));
+    }
+
+    std::size_t position(std::string const& s) const {
+      for (std::size_t i = 0; i < entries.size(); ++i)
+        if (entries[i] == s) return i;
+      return entries.size();
+    }
+
+    std::vector<std::string> entries;
+    std::mutex m;
+  };
+
+  auto record(journal& j, std::string name,
+              std::chrono::milliseconds delay = {}) {
+    return [&j, name, delay] {
+      std::this_thread::sleep_for(delay);
+      j.write(name);
+    };
+  }
+
+  /*
+   * Waits, until `count` callers have arrived or a timeout expired. Returns
+   * true, if all callers have met.
+   */
+  struct rendezvous {
+    bool arrive() {
+      ++arrived;
+      auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+      while (arrived < count) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::yield();
+      }
+      return true;
+    }
+
+    int count;
+    std::atomic<int> arrived { 0 };
+  };
+
+} // namespace
+
+TEST_CASE("Scheduler") {
+  arg::command_line cmd("--", "-");
+  journal j;
+  using namespace std::chrono_literals;
+
+  SECTION("Ordering constraint is respected") {
+    arg::command vacuum("vacuum", "", cmd, record(j, "vacuum", 20ms),
+                        arg::deferred_execution {});
+    arg::command compact("compact", "", cmd, record(j, "compact"),
+                         arg::deferred_execution {});
+    arg::command reindex("reindex", "", cmd, record(j, "reindex"),
+                         arg::deferred_execution {});
+
+    arg::scheduler s(4);
+    auto v = s.add(vacuum);
+    auto c = s.add(compact);
+    s.add(reindex);
+    s.after(c, v);
+
+    cmd.parse(svvec_t { "--compact", "--reindex", "--vacuum" });
+    auto results = s.execute();
+
+    REQUIRE(j.entries.size() == 3);
+    REQUIRE(j.position("vacuum") < j.position("compact"));
+    for (auto const& r : results) REQUIRE(r.state == arg::task_state::done);
+  }
+
+  SECTION("Independent commands overlap") {
+    rendezvous r { 2 };
+    bool met1 = false;
+    bool met2 = false;
+    arg::command first("first", "", cmd, [&] { met1 = r.arrive(); },
+                       arg::deferred_execution {});
+    arg::command second("second", "", cmd, [&] { met2 = r.arrive(); },
+                        arg::deferred_execution {});
+
+    arg::scheduler s(2);
+    s.add(first);
+    s.add(second);
+
+    cmd.parse(svvec_t { "--first", "--second" });
+    s.execute();
+
+    REQUIRE(met1);
+    REQUIRE(met2);
+  }
+
+  SECTION("Single thread keeps an order of adding") {
+    arg::command a("a", "", cmd, record(j, "a"), arg::deferred_execution {});
+    arg::command b("b", "", cmd, record(j, "b"), arg::deferred_execution {});
+    arg::command c("c", "", cmd, record(j, "c"), arg::deferred_execution {});
+
+    arg::scheduler s(1);
+    s.add(a);
+    s.add(b);
+    s.add(c);
+
+    cmd.parse(svvec_t { "-c", "-a", "-b" });
+    s.execute();
+
+    REQUIRE(j.entries == std::vector<std::string> { "a", "b", "c" });
+  }
+
+  SECTION("Inactive command is not executed, but keeps an order") {
+    arg::command a("a", "", cmd, record(j, "a", 20ms),
+                   arg::deferred_execution {});
+    arg::command b("b", "", cmd, record(j, "b"), arg::deferred_execution {});
+    arg::command c("c", "", cmd, record(j, "c"), arg::deferred_execution {});
+
+    arg::scheduler s(4);
+    auto ia = s.add(a);
+    auto ib = s.add(b);
+    auto ic = s.add(c);
+    s.after(ib, ia);
+    s.after(ic, ib);
+
+    cmd.parse(svvec_t { "-a", "-c" });
+    auto results = s.execute();
+
+    REQUIRE(j.entries == std::vector<std::string> { "a", "c" });
+    REQUIRE(results[ib].state == arg::task_state::inactive);
+    REQUIRE(results[ib].name == "b");
+  }
+
+  SECTION("Exceptions are aggregated") {
+    arg::command a("a", "", cmd, [] { throw std::runtime_error("a"); },
+                   arg::deferred_execution {});
+    arg::command b("b", "", cmd, [] { throw std::runtime_error("b"); },
+                   arg::deferred_execution {});
+    arg::command c("c", "", cmd, record(j, "c"), arg::deferred_execution {});
+    arg::command d("d", "", cmd, record(j, "d"), arg::deferred_execution {});
+
+    arg::scheduler s(2);
+    auto ia = s.add(a);
+    auto ib = s.add(b);
+    auto ic = s.add(c);
+    auto id = s.add(d);
+    s.after(ic, ia);
+
+    cmd.parse(svvec_t { "-a", "-b", "-c", "-d" });
+    auto results = s.run();
+
+    REQUIRE(results[ia].state == arg::task_state::failed);
+    REQUIRE(results[ib].state == arg::task_state::failed);
+    REQUIRE(results[ic].state == arg::task_state::skipped);
+    REQUIRE(results[id].state == arg::task_state::done);
+    REQUIRE_THROWS_AS(std::rethrow_exception(results[ia].error),
+                      std::runtime_error);
+    REQUIRE(j.entries == std::vector<std::string> { "d" });
+  }
+
+  SECTION("Execute throws an aggregated exception") {
+    arg::command a("a", "", cmd, [] { throw std::runtime_error("a"); },
+                   arg::deferred_execution {});
+    arg::command b("b", "", cmd, [] { throw std::runtime_error("b"); },
+                   arg::deferred_execution {});
+
+    arg::scheduler s(2);
+    s.add(a);
+    s.add(b);
+
+    cmd.parse(svvec_t { "-a", "-b" });
+    try {
+      s.execute();
+      FAIL("execution_error is not thrown");
+    } catch (arg::execution_error const& e) {
+      REQUIRE(e.failures().size() == 2);
+      REQUIRE(e.failures()[0].name == "a");
+      REQUIRE(e.failures()[1].name == "b");
+    }
+  }
+
+  SECTION("Cycle is an error") {
+    arg::command a("a", "", cmd, record(j, "a"), arg::deferred_execution {});
+    arg::command b("b", "", cmd, record(j, "b"), arg::deferred_execution {});
+
+    arg::scheduler s(2);
+    auto ia = s.add(a);
+    auto ib = s.add(b);
+    s.after(ia, ib);
+    s.after(ib, ia);
+
+    cmd.parse(svvec_t { "-a", "-b" });
+    REQUIRE_THROWS_AS(s.run(), arg::command_line_error);
+    REQUIRE(j.entries.empty());
+  }
+}
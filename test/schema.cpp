@@ -0,0 +1,191 @@
+#include <argueme/schema.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("schema") {
+  arg::schema s("--", "-");
+
+  auto threads = s.add_value<int>("threads", "t", arg::prefix_policy::optional,
+                                  1);
+  auto files = s.add_multi<std::string>("file", "f");
+  auto verbose = s.add_switch("verbose", "v");
+  auto input = s.add_positional<std::string_view>(true);
+  s.freeze();
+
+  SECTION("Values are stored in a result") {
+    auto res = s.parse(svvec_t { "in", "-t", "4", "--file", "a", "-f", "b",
+                                 "-v" });
+    CHECK(res.get(threads) == 4);
+    CHECK(res.get(files) == std::vector<std::string> { "a", "b" });
+    CHECK(res.get(verbose) == true);
+    CHECK(res.get(input) == "in");
+    CHECK(res.count(files) == 2);
+  }
+
+  SECTION("Default values") {
+    auto res = s.parse(svvec_t { "in" });
+    CHECK(res.get(threads) == 1);
+    CHECK(res.get(files).empty());
+    CHECK(res.get(verbose) == false);
+    CHECK(res.count(threads) == 0);
+  }
+
+  SECTION("Errors are the same as in command_line") {
+    REQUIRE_THROWS_AS(s.parse(svvec_t {}), arg::argument_error);
+    REQUIRE_THROWS_AS(s.parse(svvec_t { "in", "-t", "1", "-t", "2" }),
+                      arg::argument_error);
+    REQUIRE_THROWS_AS(s.parse(svvec_t { "in", "-t" }), arg::argument_error);
+    REQUIRE_THROWS_AS(s.parse(svvec_t { "in", "-t", "-v" }),
+                      arg::argument_error);
+    REQUIRE_THROWS_AS(s.parse(svvec_t { "in", "out" }), arg::argument_error);
+    REQUIRE_THROWS_AS(s.parse(svvec_t { "in", "-t", "x" }),
+                      arg::argument_error);
+  }
+
+  SECTION("Attached values and bundles are the same as in command_line") {
+    auto res = s.parse(svvec_t { "in", "--threads=4", "-fa", "-vfb" });
+    CHECK(res.get(threads) == 4);
+    CHECK(res.get(files) == std::vector<std::string> { "a", "b" });
+    CHECK(res.get(verbose) == true);
+
+    arg::parse_result other(s);
+    auto vec = svvec_t { "in", "--verbose=yes" };
+    auto status = s.try_parse(vec, other);
+    REQUIRE_FALSE(status);
+    CHECK(status.error().code == arg::parse_errc::unexpected_value);
+    CHECK(status.error().token == "--verbose=yes");
+  }
+
+  SECTION("Result is reset before parsing") {
+    arg::parse_result res(s);
+    svvec_t first { "in", "-t", "4", "-f", "a", "-v" };
+    svvec_t second { "in", "-f", "b" };
+
+    auto [b1, e1] = arg::details::make_cursors(first.data(), first.size());
+    s.parse(b1, e1, res);
+    auto [b2, e2] = arg::details::make_cursors(second.data(), second.size());
+    s.parse(b2, e2, res);
+
+    CHECK(res.get(threads) == 1);
+    CHECK(res.get(files) == std::vector<std::string> { "b" });
+    CHECK(res.get(verbose) == false);
+  }
+
+  SECTION("Schema can not be changed after freezing") {
+    REQUIRE_THROWS_AS(s.add_switch("other", "o"), arg::command_line_error);
+  }
+}
+
+TEST_CASE("Concurrent parsing with one schema") {
+  arg::schema s("--", "-");
+  auto number = s.add_value<int>("number", "n");
+  auto names = s.add_multi<std::string>("name", "m");
+  s.freeze();
+
+  constexpr int threads_count = 4;
+  constexpr int parses_count = 1000;
+  std::vector<int> failures(threads_count, 0);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < threads_count; ++t) {
+    threads.emplace_back([&, t] {
+      std::string value = std::to_string(t);
+      svvec_t vec { "-n", value, "--name", value, "-m", value };
+      arg::parse_result res(s);
+      auto [begin, end] = arg::details::make_cursors(vec.data(), vec.size());
+      for (int i = 0; i < parses_count; ++i) {
+        s.parse(begin, end, res);
+        if (res.get(number) != t || res.get(names).size() != 2 ||
+            res.get(names)[1] != value)
+          ++failures[t];
+      }
+    });
+  }
+  for (auto& th : threads) th.join();
+
+  for (int t = 0; t < threads_count; ++t) CHECK(failures[t] == 0);
+}
+
+TEST_CASE("Batch parsing") {
+  arg::schema s("--", "-");
+  auto level = s.add_value<int>("level", "l", arg::prefix_policy::optional, 7);
+  auto name = s.add_value<std::string>("name", "n",
+                                       arg::prefix_policy::optional, "none");
+  auto ids = s.add_multi<int>("id", "i");
+  auto force = s.add_switch("force", "f");
+  s.freeze();
+
+  std::string buffer = "-l 1 -n first -i 1 -i 2\n"
+                       "--force\n"
+                       "-l x\n"
+                       "\n"
+                       "-n last\t-f";
+
+  for (std::size_t threads : { 1, 2, 3, 8 }) {
+    INFO("threads: " << threads);
+    auto res = s.parse_batch(buffer, threads);
+
+    REQUIRE(res.size() == 5);
+    CHECK(res.column(level) == std::vector<int> { 1, 7, 7, 7, 7 });
+    CHECK(res.column(name) ==
+          std::vector<std::string> { "first", "none", "none", "none",
+                                     "last" });
+    CHECK(res.column(ids)[0] == std::vector<int> { 1, 2 });
+    CHECK(res.column(ids)[1].empty());
+    CHECK(res.column(force) ==
+          std::vector<bool> { false, true, false, false, true });
+
+    CHECK(res.failures() == 1);
+    CHECK(res.failed(2));
+    CHECK_FALSE(res.failed(3));
+    CHECK(res.error(2).code == arg::parse_errc::invalid_value);
+    CHECK(res.error(2).token == "-l");
+    CHECK(res.error(2).value == "x");
+  }
+
+  SECTION("Lines are split like a shell does") {
+    std::string quoted = "-n 'first name' -l 2\n"
+                         "-n \"x\\\"y\" -n\n"
+                         "-n a\\ b";
+    for (std::size_t threads : { 1, 2 }) {
+      INFO("threads: " << threads);
+      auto res = s.parse_batch(quoted, threads);
+
+      REQUIRE(res.size() == 3);
+      CHECK(res.column(name) ==
+            std::vector<std::string> { "first name", "none", "a b" });
+      CHECK(res.column(level) == std::vector<int> { 2, 7, 7 });
+      CHECK(res.failed(1));
+      CHECK(res.error(1).code == arg::parse_errc::repeated_option);
+    }
+  }
+
+  SECTION("Line with an unterminated quote fails alone") {
+    std::string lines = "-n a\n-n 'b\n-n c\n";
+    for (std::size_t threads : { 1, 2 }) {
+      INFO("threads: " << threads);
+      auto res = s.parse_batch(lines, threads);
+
+      REQUIRE(res.size() == 3);
+      CHECK(res.failures() == 1);
+      CHECK(res.column(name) ==
+            std::vector<std::string> { "a", "none", "c" });
+      CHECK(res.failed(1));
+      CHECK(res.error(1).code == arg::parse_errc::unterminated_quote);
+      CHECK(res.error(1).token == "-n 'b");
+    }
+  }
+
+  SECTION("Vectors of arguments") {
+    std::vector<svvec_t> lines { { "-l", "2" }, { "--unknown" }, {} };
+    auto res = s.parse_batch(lines);
+    CHECK(res.column(level) == std::vector<int> { 2, 7, 7 });
+    CHECK(res.failed(1));
+    CHECK(res.error(1).code == arg::parse_errc::unrecognized_argument);
+    CHECK(res.error(1).token == "--unknown");
+    CHECK(res.error(1).index == 0);
+  }
+}
@@ -0,0 +1,89 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("Sink argument") {
+  arg::command_line cmd("--", "-");
+
+  SECTION("Values are handed over in batches") {
+    std::vector<std::vector<int>> batches;
+    arg::sink_argument<int> level(
+        "level", "l", cmd,
+        [&](std::vector<int>& batch) { batches.push_back(batch); }, 2);
+
+    svvec_t vec { "-l1", "-l2", "-l3", "-l4", "-l5" };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(batches ==
+            std::vector<std::vector<int>> { { 1, 2 }, { 3, 4 }, { 5 } });
+    REQUIRE(level.count() == 5);
+  }
+
+  SECTION("Batch is handed over during parsing") {
+    std::size_t first_count = 0;
+    bool verbose_at_first = true;
+    arg::switch_argument verbose("verbose", "v", cmd);
+    arg::sink_argument<int> level(
+        "level", "l", cmd,
+        [&](std::vector<int>&) {
+          if (first_count != 0) return;
+          first_count = level.count();
+          verbose_at_first = verbose.get();
+        },
+        2);
+
+    svvec_t vec { "-l1", "-l2", "-v", "-l3" };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    // the first batch is handed over before `-v` and `-l3` are parsed
+    REQUIRE(first_count == 2);
+    REQUIRE_FALSE(verbose_at_first);
+    REQUIRE(verbose.get());
+  }
+
+  SECTION("Values are moved out of a batch") {
+    std::vector<std::string> files;
+    arg::sink_argument<std::string> file(
+        "file", "f", cmd,
+        [&](std::vector<std::string>& batch) {
+          for (auto& v : batch) files.push_back(std::move(v));
+        },
+        4);
+
+    svvec_t vec { "-fa", "-fb" };
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(files == std::vector<std::string> { "a", "b" });
+  }
+
+  SECTION("Values before an error are handed over") {
+    std::vector<int> values;
+    arg::sink_argument<int> level(
+        "level", "l", cmd,
+        [&](std::vector<int>& batch) {
+          values.insert(values.end(), batch.begin(), batch.end());
+        },
+        8);
+
+    svvec_t vec { "-l1", "-l2", "-lx" };
+    REQUIRE_FALSE(cmd.try_parse(vec));
+    REQUIRE(values == std::vector<int> { 1, 2 });
+  }
+
+  SECTION("Values before a throwing command are handed over") {
+    std::vector<int> values;
+    arg::sink_argument<int> level(
+        "level", "l", cmd,
+        [&](std::vector<int>& batch) {
+          values.insert(values.end(), batch.begin(), batch.end());
+        },
+        8);
+    arg::command fail("fail", "F", cmd, [] {
+      throw std::runtime_error("failed");
+    });
+
+    svvec_t vec { "-l1", "-l2", "--fail", "-l3" };
+    REQUIRE_THROWS_AS(cmd.try_parse(vec), std::runtime_error);
+    REQUIRE(values == std::vector<int> { 1, 2 });
+  }
+}
@@ -0,0 +1,404 @@
+#include <argueme/arg.hpp>
+#include <argueme/static_command_line.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+namespace {
+
+  struct int_opt : arg::static_value<int> {
+    static constexpr std::string_view longname = "int";
+    static constexpr std::string_view shortname = "i";
+  };
+
+  struct float_opt : arg::static_value<float> {
+    static constexpr std::string_view longname = "float";
+    static constexpr std::string_view shortname = "f";
+  };
+
+  struct hello_opt : arg::static_value<std::string> {
+    static constexpr std::string_view longname = "hello";
+    static constexpr std::string_view shortname = "h";
+  };
+
+  struct message_opt : arg::static_multi<std::string> {
+    static constexpr std::string_view longname = "message";
+    static constexpr std::string_view shortname = "m";
+  };
+
+  struct switch_opt : arg::static_switch<> {
+    static constexpr std::string_view longname = "switch";
+    static constexpr std::string_view shortname = "s";
+  };
+
+  struct req_int_opt : arg::static_value<int, arg::prefix_policy::require> {
+    static constexpr std::string_view longname = "int";
+    static constexpr std::string_view shortname = "i";
+  };
+
+  struct noprefix_int_opt
+      : arg::static_value<int, arg::prefix_policy::do_not_require> {
+    static constexpr std::string_view longname = "int";
+    static constexpr std::string_view shortname = "i";
+    static constexpr int default_value = 42;
+  };
+
+  struct first_pos : arg::static_positional<std::string, true> {};
+
+  struct second_pos : arg::static_positional<std::string, true> {};
+
+  struct extract_opt : arg::static_switch<> {
+    static constexpr std::string_view longname = "extract";
+    static constexpr std::string_view shortname = "x";
+  };
+
+  struct verbose_opt : arg::static_switch<> {
+    static constexpr std::string_view longname = "verbose";
+    static constexpr std::string_view shortname = "v";
+  };
+
+  struct file_opt : arg::static_value<std::string> {
+    static constexpr std::string_view longname = "file";
+    static constexpr std::string_view shortname = "f";
+  };
+
+  struct jobs_opt : arg::static_value<int> {
+    static constexpr std::string_view longname = "jobs";
+    static constexpr std::string_view shortname = "j";
+  };
+
+  struct include_opt : arg::static_multi<std::string> {
+    static constexpr std::string_view longname = "include";
+    static constexpr std::string_view shortname = "I";
+  };
+
+  struct level_opt : arg::static_value<int, arg::prefix_policy::require> {
+    static constexpr std::string_view longname = "level";
+    static constexpr std::string_view shortname = "l";
+  };
+
+  struct noprefix_opt
+      : arg::static_switch<arg::prefix_policy::do_not_require> {
+    static constexpr std::string_view longname = "no-prefix";
+    static constexpr std::string_view shortname = "n";
+  };
+
+  struct target_pos : arg::static_positional<std::string> {};
+
+  /*
+   * Result of a parsing: an error message with an argument name or values
+   * of all options, formatted as a string.
+   */
+  template <class F>
+  std::string outcome(F&& f) {
+    try {
+      return f();
+    } catch (arg::argument_error const& e) {
+      return std::string("error: ") + e.what() + ": " + e.argname();
+    }
+  }
+
+  std::string dynamic_values(svvec_t const& vec) {
+    arg::command_line cmd("--", "-");
+    arg::value_argument<int> i("int", "i", cmd);
+    arg::value_argument<float> f("float", "f", cmd);
+    arg::value_argument<std::string> h("hello", "h", cmd);
+    arg::multi_argument<std::string> m("message", "m", cmd);
+    arg::switch_argument s("switch", "s", cmd);
+    return outcome([&] {
+      cmd.parse(vec);
+      std::string res = std::to_string(i.get()) + " " +
+                        std::to_string(f.get()) + " " + h.get() + " " +
+                        std::to_string(s.get());
+      for (auto const& msg : m.get()) res += " " + msg;
+      return res;
+    });
+  }
+
+  std::string static_values(svvec_t const& vec) {
+    arg::static_command_line<int_opt, float_opt, hello_opt, message_opt,
+                             switch_opt>
+        cmd("--", "-");
+    return outcome([&] {
+      cmd.parse(vec);
+      std::string res = std::to_string(cmd.get<int_opt>()) + " " +
+                        std::to_string(cmd.get<float_opt>()) + " " +
+                        cmd.get<hello_opt>() + " " +
+                        std::to_string(cmd.get<switch_opt>());
+      for (auto const& msg : cmd.get<message_opt>()) res += " " + msg;
+      return res;
+    });
+  }
+
+
+  std::string dynamic_rich_values(svvec_t const& vec) {
+    arg::command_line cmd("--", "-");
+    arg::switch_argument x("extract", "x", cmd);
+    arg::switch_argument v("verbose", "v", cmd);
+    arg::value_argument<std::string> f("file", "f", cmd);
+    arg::value_argument<int> j("jobs", "j", cmd);
+    arg::multi_argument<std::string> inc("include", "I", cmd);
+    arg::value_argument<int> l("level", "l", cmd,
+                               arg::prefix_policy::require);
+    arg::switch_argument n("no-prefix", "n", cmd,
+                           arg::prefix_policy::do_not_require);
+    arg::positional_argument<std::string> t(cmd);
+    return outcome([&] {
+      cmd.parse(vec);
+      std::string res = std::to_string(x.get()) + " " +
+                        std::to_string(v.get()) + " " + f.get() + " " +
+                        std::to_string(j.get()) + " " +
+                        std::to_string(l.get()) + " " +
+                        std::to_string(n.get()) + " " + t.get();
+      for (auto const& i : inc.get()) res += " " + i;
+      return res;
+    });
+  }
+
+  std::string static_rich_values(svvec_t const& vec) {
+    arg::static_command_line<extract_opt, verbose_opt, file_opt, jobs_opt,
+                             include_opt, level_opt, noprefix_opt,
+                             target_pos>
+        cmd("--", "-");
+    return outcome([&] {
+      cmd.parse(vec);
+      std::string res = std::to_string(cmd.get<extract_opt>()) + " " +
+                        std::to_string(cmd.get<verbose_opt>()) + " " +
+                        cmd.get<file_opt>() + " " +
+                        std::to_string(cmd.get<jobs_opt>()) + " " +
+                        std::to_string(cmd.get<level_opt>()) + " " +
+                        std::to_string(cmd.get<noprefix_opt>()) + " " +
+                        cmd.get<target_pos>();
+      for (auto const& i : cmd.get<include_opt>()) res += " " + i;
+      return res;
+    });
+  }
+
+  std::string dynamic_positionals(svvec_t const& vec) {
+    arg::command_line cmd("--", "-");
+    arg::switch_argument s("switch", "s", cmd);
+    arg::positional_argument<std::string> first(cmd, true);
+    arg::positional_argument<std::string> second(cmd, true);
+    return outcome([&] {
+      cmd.parse(vec);
+      return std::to_string(s.get()) + " " + first.get() + " " +
+             second.get();
+    });
+  }
+
+  std::string static_positionals(svvec_t const& vec) {
+    arg::static_command_line<switch_opt, first_pos, second_pos> cmd("--",
+                                                                   "-");
+    return outcome([&] {
+      cmd.parse(vec);
+      return std::to_string(cmd.get<switch_opt>()) + " " +
+             cmd.get<first_pos>() + " " + cmd.get<second_pos>();
+    });
+  }
+} // namespace
+
+TEST_CASE("static_command_line behaves as command_line") {
+  std::vector<svvec_t> inputs {
+    {},
+    { "--hello" },
+    { "--hello", "world" },
+    { "-h", "world" },
+    { "--hello", "world", "--hello", "error" },
+    { "-i", "-f" },
+    { "-hello" },
+    { "---hello" },
+    { "--h" },
+    { "--int", "123", "--float", "3.14" },
+    { "--int", "3.14" },
+    { "--message", "hello", "-m", "beautiful", "--message", "world" },
+    { "--message" },
+    { "--message", "--message", "hello" },
+    { "--switch", "-s", "-s" },
+    { "--switch", "--unknown" },
+    { "positional" },
+  };
+
+  for (auto const& vec : inputs) {
+    std::string input;
+    for (auto s : vec) input.append(s).append(" ");
+    INFO("input: " << input);
+    CHECK(dynamic_values(vec) == static_values(vec));
+  }
+}
+
+/*
+ * Inputs of bundle, attached_value, prefix, multi_arg and pos_arg suites.
+ */
+TEST_CASE("static_command_line behaves as command_line on suite inputs") {
+  SECTION("Bundles, attached values, prefixes and repeated options") {
+    std::vector<svvec_t> inputs {
+      { "-xv" },
+      { "-xvx" },
+      { "-xvf", "archive.tar" },
+      { "-vfarchive.tar" },
+      { "-xf" },
+      { "-xq" },
+      { "--xv" },
+      { "xv" },
+      { "-xn" },
+      { "n" },
+      { "-n" },
+      { "no-prefix" },
+      { "--no-prefix" },
+      { "--jobs=8" },
+      { "-j8" },
+      { "-j=8" },
+      { "--jobs8" },
+      { "--jobs=" },
+      { "--file=--verbose" },
+      { "--file=" },
+      { "-I", "a", "-Ib", "--include=c", "--include", "d" },
+      { "--verbose=yes" },
+      { "-vx" },
+      { "-j", "1", "-j", "2" },
+      { "-f", "a", "--file", "b" },
+      { "-x", "--extract" },
+      { "-l", "3" },
+      { "--level", "3" },
+      { "--level=3" },
+      { "level", "3" },
+      { "l", "3" },
+      { "key=value" },
+      { "target", "-xv" },
+      { "target", "other" },
+      { "-f", "--verbose" },
+      { "--jobs", "x" },
+      { "--jobs" },
+    };
+
+    for (auto const& vec : inputs) {
+      std::string input;
+      for (auto s : vec) input.append(s).append(" ");
+      INFO("input: " << input);
+      CHECK(dynamic_rich_values(vec) == static_rich_values(vec));
+    }
+  }
+
+  SECTION("Mandatory positionals") {
+    std::vector<svvec_t> inputs {
+      {},
+      { "hello" },
+      { "hello", "world" },
+      { "-s", "hello", "world" },
+      { "hello", "-s", "world" },
+      { "hello", "world", "-s" },
+      { "hello", "world", "again" },
+    };
+
+    for (auto const& vec : inputs) {
+      std::string input;
+      for (auto s : vec) input.append(s).append(" ");
+      INFO("input: " << input);
+      CHECK(dynamic_positionals(vec) == static_positionals(vec));
+    }
+  }
+}
+
+TEST_CASE("static_command_line prefix policy") {
+  SECTION("Prefix required") {
+    arg::static_command_line<req_int_opt> cmd("--", "-");
+
+    REQUIRE_THROWS_AS(cmd.parse(svvec_t { "int", "1" }), arg::argument_error);
+    cmd.parse(svvec_t { "-i", "1" });
+    CHECK(cmd.get<req_int_opt>() == 1);
+  }
+
+  SECTION("Prefix does not required") {
+    arg::static_command_line<noprefix_int_opt> cmd("--", "-");
+
+    CHECK(cmd.get<noprefix_int_opt>() == 42);
+    REQUIRE_THROWS_AS(cmd.parse(svvec_t { "--int", "1" }),
+                      arg::argument_error);
+    cmd.parse(svvec_t { "i", "1" });
+    CHECK(cmd.get<noprefix_int_opt>() == 1);
+  }
+}
+
+TEST_CASE("static_command_line positional arguments") {
+  SECTION("pos args are identified by its position") {
+    arg::static_command_line<first_pos, switch_opt, second_pos> cmd("--",
+                                                                    "-");
+    cmd.parse(svvec_t { "hello", "-s", "world" });
+    CHECK(cmd.get<first_pos>() == "hello");
+    CHECK(cmd.get<second_pos>() == "world");
+    CHECK(cmd.get<switch_opt>() == true);
+  }
+
+  SECTION("Required positional arg") {
+    arg::static_command_line<first_pos, second_pos> cmd("--", "-");
+    REQUIRE_THROWS_AS(cmd.parse(svvec_t { "hello" }), arg::argument_error);
+  }
+}
+
+TEST_CASE("static_command_line try_parse") {
+  arg::static_command_line<int_opt, message_opt, switch_opt, first_pos> cmd(
+      "--", "-");
+
+  SECTION("Error is returned with a token and its index") {
+    auto status = cmd.try_parse(svvec_t { "-s", "--int", "x" });
+    REQUIRE_FALSE(status);
+    CHECK(status.error().code == arg::parse_errc::invalid_value);
+    CHECK(status.error().token == "--int");
+    CHECK(status.error().index == 1);
+    CHECK(status.error().value == "x");
+  }
+
+  SECTION("Missing positional argument") {
+    auto status = cmd.try_parse(svvec_t { "-i", "1" });
+    REQUIRE_FALSE(status);
+    CHECK(status.error().code == arg::parse_errc::positional_required);
+  }
+
+  SECTION("Value option is given again by a next parse") {
+    REQUIRE(cmd.try_parse(svvec_t { "pos", "--int", "1" }));
+    REQUIRE(cmd.try_parse(svvec_t { "pos", "--int=2" }));
+    CHECK(cmd.get<int_opt>() == 2);
+    auto status = cmd.try_parse(svvec_t { "pos", "-i3", "-i", "4" });
+    REQUIRE_FALSE(status);
+    CHECK(status.error().code == arg::parse_errc::repeated_option);
+    CHECK(status.error().index == 2);
+  }
+
+  SECTION("Empty argv is not parsed") {
+    char* argv[] = { nullptr };
+    CHECK(cmd.try_parse(argv, 0));
+    REQUIRE_NOTHROW(cmd.parse(argv, 0));
+  }
+}
+
+namespace {
+
+  struct alpha_opt : arg::static_switch<> {
+    static constexpr std::string_view longname = "alpha";
+    static constexpr std::string_view shortname = "a";
+  };
+
+  struct apply_opt : arg::static_switch<> {
+    static constexpr std::string_view longname = "apply";
+    static constexpr std::string_view shortname = "A";
+  };
+
+  struct about_opt : arg::static_value<int> {
+    static constexpr std::string_view longname = "about";
+    static constexpr std::string_view shortname = "";
+  };
+
+} // namespace
+
+TEST_CASE("static_command_line finds names with the same length and first "
+          "character") {
+  arg::static_command_line<alpha_opt, apply_opt, about_opt> cmd("--", "-");
+
+  cmd.parse(svvec_t { "--apply", "--about", "7", "-a" });
+  CHECK(cmd.get<alpha_opt>());
+  CHECK(cmd.get<apply_opt>());
+  CHECK(cmd.get<about_opt>() == 7);
+  CHECK_FALSE(cmd.is_argument("--abort"));
+  CHECK_FALSE(cmd.is_argument("--"));
+}
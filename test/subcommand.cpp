@@ -0,0 +1,99 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using svvec_t = std::vector<std::string_view>;
+
+namespace {
+
+  int created = 0;
+
+  struct build : arg::subcommand {
+    build() : arg::subcommand("--", "-") { ++created; }
+
+    arg::value_argument<int> jobs { "jobs", "j", cmdline };
+    arg::switch_argument verbose { "verbose", "v", cmdline };
+  };
+
+  struct deploy : arg::subcommand {
+    deploy() : arg::subcommand("--", "-") { ++created; }
+
+    arg::positional_argument<std::string> target { cmdline, true };
+  };
+
+} // namespace
+
+TEST_CASE("Subcommands") {
+  arg::command_line cmd("--", "-");
+  arg::switch_argument quiet("quiet", "q", cmd);
+  arg::subcommands tools(cmd);
+  tools.add<build>("build");
+  tools.add<deploy>("deploy");
+  created = 0;
+
+  SECTION("Only a matched subcommand is created") {
+    svvec_t vec { "-q", "build", "--jobs", "4", "-v" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(created == 1);
+    REQUIRE(quiet.get() == true);
+    REQUIRE(tools.name() == "build");
+    auto* b = tools.get_as<build>();
+    REQUIRE(b != nullptr);
+    REQUIRE(b->jobs.get() == 4);
+    REQUIRE(b->verbose.get() == true);
+    REQUIRE(tools.get_as<deploy>() == nullptr);
+  }
+
+  SECTION("Remaining arguments belong to a subcommand") {
+    svvec_t vec { "deploy", "-q" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(quiet.get() == false);
+    REQUIRE(tools.get_as<deploy>()->target.get() == "-q");
+  }
+
+  SECTION("No subcommand is given") {
+    svvec_t vec { "-q" };
+
+    REQUIRE_NOTHROW(cmd.parse(vec));
+    REQUIRE(created == 0);
+    REQUIRE(tools.get() == nullptr);
+  }
+
+  SECTION("Unknown subcommand") {
+    svvec_t vec { "inspect" };
+
+    auto status = cmd.try_parse(vec);
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::unrecognized_argument);
+    REQUIRE(status.error().token == "inspect");
+    REQUIRE(created == 0);
+  }
+
+  SECTION("Error of a subcommand has an index in a whole command line") {
+    svvec_t vec { "-q", "build", "-v", "--jobs", "many" };
+
+    auto status = cmd.try_parse(vec);
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().token == "--jobs");
+    REQUIRE(status.error().index == 3);
+    REQUIRE(status.error().value == "many");
+    REQUIRE_THROWS_AS(cmd.parse(vec), arg::argument_error);
+  }
+
+  SECTION("Factory may capture a state") {
+    int jobs = 0;
+    arg::command_line root("--", "-");
+    arg::subcommands sub(root, true);
+    sub.add("build", [&] {
+      auto b = std::make_unique<build>();
+      jobs = 1;
+      return b;
+    });
+
+    REQUIRE_NOTHROW(root.parse(svvec_t { "build" }));
+    REQUIRE(jobs == 1);
+    REQUIRE_THROWS_AS(root.parse(svvec_t {}), arg::argument_error);
+  }
+}
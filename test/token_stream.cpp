@@ -0,0 +1,190 @@
+#include <argueme/token_stream.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <ios>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+  /*
+   * Stream buffer, which gives `text` and then fails to read.
+   */
+  class failing_buf : public std::streambuf {
+  public:
+    explicit failing_buf(std::string s) : text(std::move(s)) {
+      setg(text.data(), text.data(), text.data() + text.size());
+    }
+
+  protected:
+    virtual int_type underflow() override {
+      throw std::ios_base::failure("read failed");
+    }
+
+  private:
+    std::string text;
+  };
+
+} // namespace
+
+TEST_CASE("Token stream") {
+  arg::command_line cmd("--", "-");
+  arg::multi_argument<std::string> include("include", "I", cmd);
+  arg::value_argument<int> jobs("jobs", "j", cmd);
+  arg::positional_argument<std::string> target(cmd);
+
+  SECTION("Arguments are read from std::istream") {
+    std::istringstream is("-I a --jobs=3\n  -I\tb\n\ntarget -Ic");
+    arg::token_stream input(is);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+    REQUIRE(include.get() == std::vector<std::string> { "a", "b", "c" });
+    REQUIRE(jobs.get() == 3);
+    REQUIRE(target.get() == "target");
+    REQUIRE(input.arguments_count() == 7);
+  }
+
+  SECTION("Arguments longer than a buffer") {
+    std::string path(100, 'x');
+    std::istringstream is("-I " + path + " -I " + path + "y");
+    arg::token_stream input(is, arg::token_separator::whitespace, 7);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+    REQUIRE(include.get() == std::vector<std::string> { path, path + "y" });
+  }
+
+  SECTION("Arguments are separated by new lines") {
+    std::istringstream is("--include\nwith space\n-j\n2\n");
+    arg::token_stream input(is, arg::token_separator::newline);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+    REQUIRE(include.get() == std::vector<std::string> { "with space" });
+    REQUIRE(jobs.get() == 2);
+  }
+
+  SECTION("Arguments are terminated by null characters") {
+    std::string data("-I", 2);
+    data.append(1, '\0').append("a b").append(1, '\0');
+    std::istringstream is(data);
+    arg::token_stream input(is, arg::token_separator::null);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+    REQUIRE(include.get() == std::vector<std::string> { "a b" });
+  }
+
+  SECTION("Empty stream") {
+    std::istringstream is(" \n ");
+    arg::token_stream input(is);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE(begin == end);
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+  }
+
+  SECTION("Error refers to a streamed argument") {
+    std::istringstream is("-I a --jobs many");
+    arg::token_stream input(is);
+
+    auto [begin, end] = input.cursors();
+    auto status = cmd.try_parse(begin, end);
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().token == "--jobs");
+    REQUIRE(status.error().index == 2);
+    REQUIRE(status.error().value == "many");
+  }
+
+  SECTION("Read error is an error of a parse") {
+    failing_buf buf("-I a -I b -j");
+    std::istream is(&buf);
+    arg::token_stream input(is);
+
+    auto [begin, end] = input.cursors();
+    auto status = cmd.try_parse(begin, end);
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::read_error);
+    REQUIRE(input.failed());
+    REQUIRE(include.get() == std::vector<std::string> { "a", "b" });
+  }
+
+  SECTION("Read error of the first argument") {
+    arg::token_stream input(-1);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE(input.failed());
+    REQUIRE_THROWS_AS(cmd.parse(begin, end), arg::argument_error);
+  }
+
+  SECTION("Arguments are read from FILE*") {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    std::fputs("-I a\n-I b\n", file);
+    std::rewind(file);
+    arg::token_stream input(file);
+
+    auto [begin, end] = input.cursors();
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+    std::fclose(file);
+    REQUIRE(include.get() == std::vector<std::string> { "a", "b" });
+    REQUIRE_FALSE(input.failed());
+  }
+
+  SECTION("Values are consumed as a pipe is written") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+
+    std::promise<void> first_value;
+    auto consumed = first_value.get_future();
+    std::vector<std::string> values;
+    include.on_value([&](std::string&& v) {
+      values.push_back(std::move(v));
+      if (values.size() == 1) first_value.set_value();
+    });
+
+    // the rest is written, only after the first value has been consumed
+    std::thread writer([&] {
+      std::string head = "-I first\n";
+      ::write(fds[1], head.data(), head.size());
+      if (consumed.wait_for(std::chrono::seconds(1)) ==
+          std::future_status::ready) {
+        std::string tail = "-I second\n";
+        ::write(fds[1], tail.data(), tail.size());
+      }
+      ::close(fds[1]);
+    });
+
+    arg::token_stream input(fds[0]);
+    auto [begin, end] = input.cursors();
+    REQUIRE_NOTHROW(cmd.parse(begin, end));
+    writer.join();
+    ::close(fds[0]);
+
+    REQUIRE(values == std::vector<std::string> { "first", "second" });
+    REQUIRE(include.get().empty());
+  }
+}
+
+TEST_CASE("Value callback") {
+  arg::command_line cmd("--", "-");
+  arg::multi_argument<int> level("level", "l", cmd);
+
+  int sum = 0;
+  level.on_value([&](int&& v) { sum += v; });
+
+  std::vector<std::string_view> vec { "-l1", "-l", "2", "--level=3" };
+  REQUIRE_NOTHROW(cmd.parse(vec));
+  REQUIRE(sum == 6);
+  REQUIRE(level.get().empty());
+
+  level.on_value(nullptr);
+  REQUIRE_NOTHROW(cmd.parse(vec));
+  REQUIRE(level.get() == std::vector<int> { 1, 2, 3 });
+}
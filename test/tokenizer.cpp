@@ -0,0 +1,72 @@
+#include <argueme/arg.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using svvec_t = std::vector<std::string_view>;
+
+namespace {
+
+  svvec_t tokenize(std::string_view line, std::string& storage) {
+    svvec_t out;
+    arg::details::tokenize(line, out, storage);
+    return out;
+  }
+
+} // namespace
+
+TEST_CASE("Command line tokenizer") {
+  std::string storage;
+
+  SECTION("Plain arguments are views of a line") {
+    std::string line = "  run --jobs\t8  -v\n";
+    auto args = tokenize(line, storage);
+    CHECK(args == svvec_t { "run", "--jobs", "8", "-v" });
+    CHECK(args[1].data() == line.data() + 6);
+    CHECK(storage.empty());
+  }
+
+  SECTION("Quotes and escapes") {
+    auto args = tokenize(R"(-m 'it is' -m "say \"hi\"" a\ b "" 'x'"y"z)",
+                         storage);
+    CHECK(args ==
+          svvec_t { "-m", "it is", "-m", "say \"hi\"", "a b", "", "xyz" });
+  }
+
+  SECTION("Long arguments cross vector blocks") {
+    std::string plain(100, 'a');
+    std::string quoted = plain + "\\ " + plain;
+    std::string line = plain + " " + quoted + "\t" + plain + "\"q\"";
+    auto args = tokenize(line, storage);
+    REQUIRE(args.size() == 3);
+    CHECK(args[0] == plain);
+    CHECK(args[1] == plain + " " + plain);
+    CHECK(args[2] == plain + "q");
+  }
+
+  SECTION("Special character at every position") {
+    for (std::size_t i = 0; i < 70; ++i) {
+      std::string line(70, 'x');
+      line[i] = ' ';
+      auto args = tokenize(line, storage);
+      std::size_t expected = (i == 0 || i == 69) ? 1 : 2;
+      CHECK(args.size() == expected);
+    }
+  }
+
+  SECTION("Unterminated quote") {
+    REQUIRE_THROWS_AS(tokenize("a 'b", storage), arg::argument_error);
+    REQUIRE_THROWS_AS(tokenize("a \"b\\\"", storage), arg::argument_error);
+  }
+}
+
+TEST_CASE("Parsing a whole command line") {
+  arg::command_line cmd("--", "-");
+  arg::value_argument<int> jobs("jobs", "j", cmd);
+  arg::multi_argument<std::string_view> msg("message", "m", cmd);
+
+  std::string line = "--jobs 8 -m plain -m 'with space'";
+  cmd.parse_line(line);
+
+  CHECK(jobs.get() == 8);
+  CHECK(msg.get() == svvec_t { "plain", "with space" });
+}
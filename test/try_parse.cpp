@@ -0,0 +1,159 @@
+#include <argueme/arg.hpp>
+#include <argueme/schema.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using svvec_t = std::vector<std::string_view>;
+
+TEST_CASE("try_parse") {
+  arg::command_line cmd("--", "-");
+  arg::value_argument<int> i("int", "i", cmd);
+  arg::multi_argument<int> m("multi", "m", cmd);
+  arg::switch_argument s("switch", "s", cmd);
+  arg::value_argument<int> r("require", "r", cmd,
+                             arg::prefix_policy::require);
+
+  SECTION("Valid arguments") {
+    svvec_t vec { "-i", "1", "--multi=2", "-s" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE(status);
+    REQUIRE(status.error().code == arg::parse_errc::ok);
+    REQUIRE(i.get() == 1);
+    REQUIRE(m.get() == std::vector<int> { 2 });
+  }
+
+  SECTION("Unrecognized argument") {
+    svvec_t vec { "-s", "--unknown" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::unrecognized_argument);
+    REQUIRE(status.error().token == "--unknown");
+    REQUIRE(status.error().index == 1);
+  }
+
+  SECTION("Index counts values of options") {
+    svvec_t vec { "-i", "1", "-m", "2", "-x" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().token == "-x");
+    REQUIRE(status.error().index == 4);
+  }
+
+  SECTION("Prefix error") {
+    svvec_t vec { "require", "1" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::prefix_error);
+    REQUIRE(status.error().token == "require");
+  }
+
+  SECTION("Option requires a value") {
+    svvec_t vec { "-m", "-s" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::value_required);
+    REQUIRE(status.error().token == "-m");
+    REQUIRE(status.error().index == 0);
+  }
+
+  SECTION("Option can be appeared only once") {
+    svvec_t vec { "-i", "1", "-i", "2" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::repeated_option);
+    REQUIRE(status.error().index == 2);
+  }
+
+  SECTION("Option does not take a value") {
+    svvec_t vec { "--switch=1" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::unexpected_value);
+  }
+
+  SECTION("Invalid value") {
+    svvec_t vec { "-s", "--multi", "12x" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().token == "--multi");
+    REQUIRE(status.error().index == 1);
+    REQUIRE(status.error().value == "12x");
+  }
+
+  SECTION("Positional argument required") {
+    arg::positional_argument<std::string> pos(cmd, true);
+    svvec_t vec { "-s" };
+    auto status = cmd.try_parse(vec);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::positional_required);
+    REQUIRE(status.error().token.empty());
+    REQUIRE(status.error().index == 1);
+  }
+
+  SECTION("parse throws an error of try_parse") {
+    svvec_t vec { "--int", "abc" };
+
+    try {
+      cmd.parse(vec);
+      FAIL("argument_error is not thrown");
+    } catch (arg::argument_error const& e) {
+      REQUIRE(std::string(e.what()) == "Cannot convert a string `abc` to a "
+                                       "value");
+      REQUIRE(std::string(e.argname()) == "--int");
+    }
+  }
+
+  SECTION("Command line can be parsed again after an error") {
+    svvec_t bad { "--unknown" };
+    svvec_t good { "-m", "3" };
+
+    REQUIRE_FALSE(cmd.try_parse(bad));
+    REQUIRE(cmd.try_parse(good));
+    REQUIRE(m.get() == std::vector<int> { 3 });
+  }
+}
+
+TEST_CASE("try_parse with schema") {
+  arg::schema s("--", "-");
+  auto level = s.add_value<int>("level", "l", arg::prefix_policy::optional, 7);
+  s.add_switch("force", "f");
+  s.freeze();
+  arg::parse_result res(s);
+
+  SECTION("Valid arguments") {
+    svvec_t vec { "-f", "--level", "3" };
+
+    REQUIRE(s.try_parse(vec, res));
+    REQUIRE(res.get(level) == 3);
+  }
+
+  SECTION("Invalid value") {
+    svvec_t vec { "-f", "-lx" };
+    auto status = s.try_parse(vec, res);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::invalid_value);
+    REQUIRE(status.error().token == "-lx");
+    REQUIRE(status.error().index == 1);
+    REQUIRE(status.error().value == "x");
+    REQUIRE(res.get(level) == 7);
+  }
+
+  SECTION("Index counts values of options") {
+    svvec_t vec { "-l", "1", "-f", "-x" };
+    auto status = s.try_parse(vec, res);
+
+    REQUIRE_FALSE(status);
+    REQUIRE(status.error().code == arg::parse_errc::unrecognized_argument);
+    REQUIRE(status.error().index == 3);
+  }
+}